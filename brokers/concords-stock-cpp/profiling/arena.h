@@ -0,0 +1,100 @@
+/**
+ * Bump-pointer arena for per-cycle order state.
+ *
+ * Everything an order lifecycle needs to remember (ids copied out of the
+ * result structs, scratch strings) is carved from one preallocated,
+ * page-touched buffer and released between cycles by resetting a single
+ * pointer — no allocator traffic or page faults inside the timed window.
+ * Single-threaded by design: the owner resets between cycles while no
+ * callback is in flight.
+ *
+ * LockAllMemory() pins the whole probe (current and future mappings) so no
+ * sample ever eats a major fault; needs CAP_IPC_LOCK or a generous
+ * RLIMIT_MEMLOCK in containers.
+ */
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+namespace latencylab {
+
+inline bool LockAllMemory() {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    std::cerr << "mlockall failed (need CAP_IPC_LOCK?); "
+              << "major faults may contaminate samples" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+class CycleArena {
+ public:
+  explicit CycleArena(size_t bytes) : size_(bytes) {
+    base_ = static_cast<char*>(mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (base_ == MAP_FAILED) {
+      std::cerr << "CycleArena: mmap of " << bytes << " bytes failed"
+                << std::endl;
+      base_ = nullptr;
+      size_ = 0;
+      return;
+    }
+    // First-touch every page now, not mid-cycle.
+    for (size_t off = 0; off < bytes; off += 4096) {
+      base_[off] = 0;
+    }
+    next_ = base_;
+  }
+
+  ~CycleArena() {
+    if (base_) munmap(base_, size_);
+  }
+
+  CycleArena(const CycleArena&) = delete;
+  CycleArena& operator=(const CycleArena&) = delete;
+
+  void* Allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+    uintptr_t p = reinterpret_cast<uintptr_t>(next_);
+    p = (p + align - 1) & ~(align - 1);
+    char* aligned = reinterpret_cast<char*>(p);
+    if (aligned + bytes > base_ + size_) {
+      overflowed_ = true;
+      return nullptr;
+    }
+    next_ = aligned + bytes;
+    return aligned;
+  }
+
+  // Copy a string into the arena; the view is valid until Reset().
+  std::string_view CopyString(std::string_view s) {
+    char* dst = static_cast<char*>(Allocate(s.size() + 1, 1));
+    if (!dst) return {};
+    memcpy(dst, s.data(), s.size());
+    dst[s.size()] = '\0';
+    return {dst, s.size()};
+  }
+
+  // Release everything from this cycle: one pointer store.
+  void Reset() {
+    next_ = base_;
+    overflowed_ = false;
+  }
+
+  size_t Used() const { return static_cast<size_t>(next_ - base_); }
+  bool Overflowed() const { return overflowed_; }
+
+ private:
+  char* base_ = nullptr;
+  char* next_ = nullptr;
+  size_t size_ = 0;
+  bool overflowed_ = false;
+};
+
+}  // namespace latencylab
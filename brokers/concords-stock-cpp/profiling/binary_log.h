@@ -0,0 +1,145 @@
+/**
+ * Memory-mapped fixed-record latency log.
+ *
+ * The file is sized up front and mapped once, so Append() on the measurement
+ * path is a bounds check plus a 24-byte store into warm pages — no
+ * allocation, no write syscall, no flush. Flushing is left to the kernel's
+ * writeback (and an msync on Close). Readers can consume a live file: the
+ * header's record_count is published with a release store after each record
+ * is fully written.
+ *
+ * Dump with log_reader: ./log_reader latency.bin > samples.csv
+ */
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include "stages.h"
+
+namespace latencylab {
+
+constexpr uint32_t kLogMagic = 0x4c42'4c4c;  // "LLBL"
+constexpr uint16_t kLogVersion = 1;
+
+constexpr uint32_t kBrokerIdConcords = 1;
+constexpr uint32_t kBrokerIdSinotrade = 2;
+
+struct LogRecord {
+  uint64_t timestamp_ns;  // begin of the stage, CLOCK epoch of the writer
+  uint64_t duration_ns;
+  uint32_t broker_id;
+  uint16_t stage_id;
+  uint16_t flags;
+};
+static_assert(sizeof(LogRecord) == 24, "LogRecord layout is the wire format");
+
+struct LogHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t record_size;
+  uint32_t broker_id;
+  uint32_t reserved;
+  uint64_t capacity;      // max records the mapping can hold
+  uint64_t record_count;  // published with release semantics
+  uint64_t dropped;       // appends refused because the file was full
+};
+static_assert(sizeof(LogHeader) == 40, "LogHeader layout is the wire format");
+
+class BinaryLog {
+ public:
+  BinaryLog() = default;
+  ~BinaryLog() { Close(); }
+
+  BinaryLog(const BinaryLog&) = delete;
+  BinaryLog& operator=(const BinaryLog&) = delete;
+
+  bool Open(const char* path, uint32_t broker_id, uint64_t capacity_records) {
+    size_t bytes = sizeof(LogHeader) + capacity_records * sizeof(LogRecord);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      std::cerr << "BinaryLog: cannot open " << path << std::endl;
+      return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+      std::cerr << "BinaryLog: cannot size " << path << std::endl;
+      close(fd);
+      return false;
+    }
+
+    void* base = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);  // mapping keeps the file alive
+    if (base == MAP_FAILED) {
+      std::cerr << "BinaryLog: mmap failed for " << path << std::endl;
+      return false;
+    }
+
+    bytes_ = bytes;
+    header_ = static_cast<LogHeader*>(base);
+    records_ = reinterpret_cast<LogRecord*>(header_ + 1);
+
+    // Touch every page before the header goes in, so appends never take a
+    // first-touch fault (the file is freshly truncated, so zeroes are safe).
+    for (size_t off = 0; off < bytes; off += 4096) {
+      static_cast<volatile char*>(base)[off] = 0;
+    }
+
+    header_->magic = kLogMagic;
+    header_->version = kLogVersion;
+    header_->record_size = sizeof(LogRecord);
+    header_->broker_id = broker_id;
+    header_->reserved = 0;
+    header_->capacity = capacity_records;
+    header_->record_count = 0;
+    header_->dropped = 0;
+
+    next_.store(0, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool IsOpen() const { return header_ != nullptr; }
+
+  // Measurement-path append: bounds check + record store + count publish.
+  void Append(Stage stage, uint64_t timestamp_ns, uint64_t duration_ns,
+              uint16_t flags = 0) noexcept {
+    if (!header_) return;
+    uint64_t slot = next_.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= header_->capacity) {
+      __atomic_add_fetch(&header_->dropped, 1, __ATOMIC_RELAXED);
+      return;
+    }
+    LogRecord& rec = records_[slot];
+    rec.timestamp_ns = timestamp_ns;
+    rec.duration_ns = duration_ns;
+    rec.broker_id = header_->broker_id;
+    rec.stage_id = static_cast<uint16_t>(stage);
+    rec.flags = flags;
+    __atomic_store_n(&header_->record_count, slot + 1, __ATOMIC_RELEASE);
+  }
+
+  void Close() {
+    if (!header_) return;
+    msync(header_, bytes_, MS_SYNC);
+    munmap(header_, bytes_);
+    header_ = nullptr;
+    records_ = nullptr;
+    bytes_ = 0;
+  }
+
+ private:
+  LogHeader* header_ = nullptr;
+  LogRecord* records_ = nullptr;
+  size_t bytes_ = 0;
+  std::atomic<uint64_t> next_{0};
+};
+
+}  // namespace latencylab
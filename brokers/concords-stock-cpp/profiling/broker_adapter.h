@@ -0,0 +1,66 @@
+/**
+ * Broker-adapter interface for the cross-broker comparison harness.
+ *
+ * The Sinotrade and Concords probes implement the same lifecycle —
+ * submit, time to first order-state callback, cancel, report — in two
+ * languages with different overhead floors, so their README numbers are
+ * not apples-to-apples. This interface mirrors the stock-client callback
+ * shape without including it, so any broker with a C/C++ SDK can be
+ * wrapped and driven by the one C++ measurement loop (broker_compare.cpp)
+ * on an identical substrate.
+ *
+ * Adapters own their session and their probe order; the harness only
+ * drives the lifecycle and stamps the clock. Callbacks fire on whatever
+ * thread the wrapped SDK dispatches from, same as the raw clients.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace latencylab {
+
+// Mirrors concordsapi::stockclient::OrderSubmitResult so non-Concords
+// adapters need no Concords headers.
+struct BrokerSubmitAck {
+  bool success = false;
+  std::string order_id;
+  std::string order_ticket_id;
+  std::string error_message;
+};
+
+struct BrokerCancelAck {
+  bool success = false;
+  std::string error_message;
+};
+
+class BrokerAdapter {
+ public:
+  virtual ~BrokerAdapter() = default;
+
+  // Short name for printouts and histogram labels.
+  virtual const char* Name() const = 0;
+  // Broker id for the binary log and report packets (binary_log.h).
+  virtual uint32_t BrokerId() const = 0;
+
+  virtual bool Connect() = 0;
+  virtual bool Login() = 0;
+  virtual bool IsConnected() = 0;
+  virtual void Disconnect() = 0;
+
+  // Submit/cancel the adapter's prepared probe order. Both are
+  // fire-and-forget like the SDK calls they wrap; completion arrives on
+  // the callbacks.
+  virtual void SubmitProbeOrder() = 0;
+  virtual void CancelProbeOrder(const std::string& order_id,
+                                const std::string& order_ticket_id) = 0;
+
+  virtual void SetSubmitCallback(
+      std::function<void(const BrokerSubmitAck&)> callback) = 0;
+  virtual void SetCancelCallback(
+      std::function<void(const BrokerCancelAck&)> callback) = 0;
+};
+
+}  // namespace latencylab
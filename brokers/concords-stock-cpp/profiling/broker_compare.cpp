@@ -0,0 +1,238 @@
+/**
+ * Cross-broker comparison harness: one C++ measurement loop for every
+ * wrapped SDK.
+ *
+ * The Python probes add interpreter and GIL jitter that the C++ probe
+ * does not have, so cross-broker README numbers compare probe overheads
+ * as much as brokers. This harness drives every broker through the same
+ * BrokerAdapter interface (broker_adapter.h) with the trading-hours
+ * scheduling loop from the Python run_latency_test — HH:MM window,
+ * Mon-Fri, fixed interval — implemented once, so each broker sees an
+ * identical lifecycle and overhead floor. Samples land in one binary log
+ * with the adapter index in the record flags; per-adapter percentiles
+ * print at exit.
+ *
+ * Today the only adapter is Concords (concords_adapter.h); new C/C++
+ * SDKs get a sibling adapter header and one line in buildAdapters().
+ *
+ * Config: the usual [user]/[order] sections plus [trading_hours]
+ * (start_time, end_time, interval_seconds — same shape as the Python
+ * configs). Without [trading_hours] the loop runs on --interval.
+ *
+ * Usage:
+ *     ./broker_compare --config compare_config.toml [--log latency.bin]
+ *                      [--cycles N] [--interval 10]
+ */
+
+#include <toml++/toml.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "binary_log.h"
+#include "broker_adapter.h"
+#include "completion.h"
+#include "concords_adapter.h"
+#include "histogram.h"
+#include "log_ring.h"
+#include "trading_hours.h"
+#include "tsc_clock.h"
+
+using latencylab::BinaryLog;
+using latencylab::BrokerAdapter;
+using latencylab::BrokerCancelAck;
+using latencylab::BrokerSubmitAck;
+using latencylab::Completion;
+using latencylab::LatencyHistogram;
+using latencylab::LogRingWriter;
+using latencylab::ProbeClock;
+using latencylab::Stage;
+using latencylab::TradingHours;
+
+BinaryLog g_latency_log;
+LogRingWriter g_log_writer(g_latency_log);
+
+std::atomic<bool> g_stop_requested{false};
+
+void handleStopSignal(int) { g_stop_requested = true; }
+
+// One measured broker: the adapter plus the per-broker completion state,
+// mirroring the Session struct of the multi-session engine.
+struct Lane {
+  int index = 0;
+  std::unique_ptr<BrokerAdapter> adapter;
+  Completion submit_done{false};
+  Completion cancel_done{false};
+  LatencyHistogram histogram;
+  std::string order_id;
+  std::string order_ticket_id;
+  uint64_t start_ns = 0;
+};
+
+std::vector<std::unique_ptr<Lane>> buildAdapters(const toml::table& config) {
+  std::vector<std::unique_ptr<Lane>> lanes;
+  auto lane = std::make_unique<Lane>();
+  lane->adapter = latencylab::MakeConcordsAdapter(config);
+  lanes.push_back(std::move(lane));
+  // Additional C/C++ SDK adapters slot in here.
+  for (size_t i = 0; i < lanes.size(); i++) {
+    lanes[i]->index = static_cast<int>(i);
+  }
+  return lanes;
+}
+
+// Interruptible sleep so Ctrl-C during a long wait exits promptly.
+void sleepSeconds(int seconds) {
+  for (int waited = 0; waited < seconds && !g_stop_requested; waited++) {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+}
+
+// One submit/cancel exchange on one lane; identical for every broker.
+void runExchange(Lane& lane) {
+  lane.start_ns = ProbeClock::NowNs();
+  lane.adapter->SubmitProbeOrder();
+
+  if (!lane.submit_done.WaitNext(std::chrono::seconds(10))) {
+    std::cerr << lane.adapter->Name() << ": submit timeout" << std::endl;
+    return;
+  }
+
+  if (!lane.order_id.empty()) {
+    lane.adapter->CancelProbeOrder(lane.order_id, lane.order_ticket_id);
+    if (!lane.cancel_done.WaitNext(std::chrono::seconds(10))) {
+      std::cerr << lane.adapter->Name() << ": cancel timeout" << std::endl;
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const char* config_path = "compare_config.toml";
+  const char* log_path = nullptr;
+  int cycles = 0;  // 0 = until stopped
+  int interval_seconds = 10;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+      config_path = argv[++i];
+    } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+      log_path = argv[++i];
+    } else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+      cycles = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+      interval_seconds = atoi(argv[++i]);
+      if (interval_seconds <= 0) {
+        std::cerr << "Invalid interval: " << argv[i] << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  ProbeClock::Calibrate();
+
+  auto config = toml::parse_file(config_path);
+  TradingHours hours = latencylab::LoadTradingHours(config);
+  if (hours.enabled) {
+    interval_seconds = hours.interval_seconds;
+  }
+
+  if (log_path) {
+    if (!g_latency_log.Open(log_path, latencylab::kBrokerIdConcords,
+                            1 << 20)) {
+      return 1;
+    }
+    g_log_writer.Start();
+  }
+
+  signal(SIGINT, handleStopSignal);
+  signal(SIGTERM, handleStopSignal);
+
+  std::vector<std::unique_ptr<Lane>> lanes = buildAdapters(config);
+  for (auto& lane_ptr : lanes) {
+    Lane* lane = lane_ptr.get();
+    lane->adapter->SetSubmitCallback([lane](const BrokerSubmitAck& ack) {
+      uint64_t end_ns = ProbeClock::NowNs();
+      uint64_t total_ns = end_ns - lane->start_ns;
+      lane->histogram.Record(total_ns);
+      if (g_latency_log.IsOpen()) {
+        // Adapter index in the flags, like the multi-session engine's
+        // session index.
+        g_log_writer.Append(Stage::kSubmitTotal, lane->start_ns, total_ns,
+                            static_cast<uint16_t>(lane->index));
+      }
+      lane->order_id.clear();
+      if (ack.success) {
+        lane->order_id = ack.order_id;
+        lane->order_ticket_id = ack.order_ticket_id;
+      } else {
+        std::cerr << lane->adapter->Name()
+                  << ": submit failed: " << ack.error_message << std::endl;
+      }
+      lane->submit_done.Signal();
+    });
+    lane->adapter->SetCancelCallback([lane](const BrokerCancelAck& ack) {
+      if (!ack.success) {
+        std::cerr << lane->adapter->Name()
+                  << ": cancel failed: " << ack.error_message << std::endl;
+      }
+      lane->cancel_done.Signal();
+    });
+  }
+
+  // Serial connect/login, as in the multi-session engine.
+  for (auto& lane : lanes) {
+    if (!lane->adapter->Connect()) {
+      std::cerr << lane->adapter->Name() << ": failed to connect" << std::endl;
+      return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    if (!lane->adapter->Login()) {
+      std::cerr << lane->adapter->Name() << ": failed to login" << std::endl;
+      return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+  std::cerr << lanes.size() << " broker(s) connected and logged in"
+            << std::endl;
+
+  int cycle_count = 0;
+  bool announced_wait = false;
+  while (!g_stop_requested && (cycles == 0 || cycle_count < cycles)) {
+    if (!hours.InWindow(time(nullptr))) {
+      if (!announced_wait) {
+        std::cerr << "Waiting for trading hours ("
+                  << TradingHours::TaiwanHhmm(time(nullptr)) << " UTC+8)"
+                  << std::endl;
+        announced_wait = true;
+      }
+      sleepSeconds(60);
+      continue;
+    }
+    announced_wait = false;
+
+    cycle_count++;
+    for (auto& lane : lanes) {
+      if (g_stop_requested) break;
+      runExchange(*lane);
+    }
+    sleepSeconds(interval_seconds);
+  }
+
+  for (auto& lane : lanes) {
+    lane->histogram.Print(std::cerr, lane->adapter->Name());
+    if (lane->adapter->IsConnected()) {
+      lane->adapter->Disconnect();
+    }
+  }
+  return 0;
+}
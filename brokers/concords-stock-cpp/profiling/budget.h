@@ -0,0 +1,100 @@
+/**
+ * Per-stage latency budgets: live SLO assertions on the stage stream.
+ *
+ * The lab exists to enforce SLOs, but breaches used to surface only in
+ * offline analysis. With --budget the probe checks every stage sample
+ * against a declared budget as its timestamps arrive — the check is one
+ * array load and compare riding the instrumentation that already stamped
+ * the sample — and a breach emits a kBudgetBreach record naming the
+ * violated stage with its measured value, plus a cerr line for eyes on
+ * the console.
+ *
+ * Config ([budget] section; keys are stage names as log_reader prints
+ * them, values are milliseconds):
+ *     [budget]
+ *     order_build = 0.05     # local build <= 50us
+ *     submit_total = 10      # Endpoint ACK <= 10ms
+ *     cancel_total = 40      # Midend confirm <= 40ms
+ *
+ * A key that matches no stage exits at startup — a misspelled SLO that
+ * silently never fires is worse than none.
+ */
+
+#pragma once
+
+#include <toml++/toml.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "log_ring.h"
+#include "stages.h"
+
+namespace latencylab {
+
+class BudgetChecker {
+ public:
+  // Reads the [budget] section; returns false when absent (--budget
+  // without one is a config error the caller reports).
+  bool Configure(const toml::table& config) {
+    const toml::table* budget = config["budget"].as_table();
+    if (!budget) {
+      return false;
+    }
+    size_t matched = 0;
+    for (int s = 0; s < static_cast<int>(Stage::kStageCount); s++) {
+      auto ms = (*budget)[StageName(static_cast<Stage>(s))].value<double>();
+      if (!ms) {
+        continue;
+      }
+      if (*ms <= 0) {
+        std::cerr << "Invalid budget for " << StageName(static_cast<Stage>(s))
+                  << ": " << *ms << std::endl;
+        exit(1);
+      }
+      budget_ns_[s] = static_cast<uint64_t>(*ms * 1e6);
+      matched++;
+    }
+    if (matched != budget->size()) {
+      std::cerr << "[budget] has a key that names no stage" << std::endl;
+      exit(1);
+    }
+    if (matched == 0) {
+      return false;
+    }
+    enabled_ = true;
+    return true;
+  }
+
+  bool Enabled() const { return enabled_; }
+
+  // `writer` may be null (no --log): breaches are then cerr-only.
+  void Arm(LogRingWriter* writer) { writer_ = writer; }
+
+  // One sample; called wherever a stage duration is stamped. Within
+  // budget this is a load and a compare.
+  void Observe(Stage stage, uint64_t start_ns, uint64_t duration_ns) {
+    if (!enabled_) {
+      return;
+    }
+    uint64_t budget = budget_ns_[static_cast<int>(stage)];
+    if (budget == 0 || duration_ns <= budget) {
+      return;
+    }
+    if (writer_) {
+      writer_->Append(Stage::kBudgetBreach, start_ns, duration_ns,
+                      static_cast<uint16_t>(stage));
+    }
+    std::cerr << "BUDGET BREACH: " << StageName(stage) << " "
+              << (duration_ns / 1e6) << "ms > " << (budget / 1e6) << "ms"
+              << std::endl;
+  }
+
+ private:
+  bool enabled_ = false;
+  LogRingWriter* writer_ = nullptr;
+  uint64_t budget_ns_[static_cast<int>(Stage::kStageCount)] = {};
+};
+
+}  // namespace latencylab
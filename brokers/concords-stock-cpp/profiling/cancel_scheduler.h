@@ -0,0 +1,90 @@
+/**
+ * Deferred-work thread for order cancels.
+ *
+ * The submit callback used to sleep_for(1s) before calling CancelOrder,
+ * which parked the SDK's callback thread for a second per cycle and capped
+ * the sample rate. Cancels are now handed to this scheduler with a
+ * configurable delay (down to 0) and fired from its own thread, so the SDK
+ * thread returns immediately and cancel issue time is under our control —
+ * which also lets the cancel path get its own START/END pair.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace latencylab {
+
+class CancelScheduler {
+ public:
+  using Fn = std::function<void()>;
+
+  CancelScheduler() : worker_([this] { Run(); }) {}
+
+  ~CancelScheduler() {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      stopping_ = true;
+    }
+    cv_.notify_one();
+    worker_.join();
+  }
+
+  CancelScheduler(const CancelScheduler&) = delete;
+  CancelScheduler& operator=(const CancelScheduler&) = delete;
+
+  // Coarser durations (the usual milliseconds) convert implicitly.
+  void ScheduleAfter(std::chrono::nanoseconds delay, Fn fn) {
+    auto when = std::chrono::steady_clock::now() + delay;
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      pending_.push_back({when, std::move(fn)});
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  struct Entry {
+    std::chrono::steady_clock::time_point when;
+    Fn fn;
+  };
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (true) {
+      if (stopping_) return;
+      if (pending_.empty()) {
+        cv_.wait(lock);
+        continue;
+      }
+      // The pending list stays tiny (one cancel per in-flight order), so a
+      // linear scan for the earliest entry beats a real timer wheel here.
+      size_t next = 0;
+      for (size_t i = 1; i < pending_.size(); i++) {
+        if (pending_[i].when < pending_[next].when) next = i;
+      }
+      auto when = pending_[next].when;
+      if (cv_.wait_until(lock, when) == std::cv_status::timeout ||
+          std::chrono::steady_clock::now() >= when) {
+        Fn fn = std::move(pending_[next].fn);
+        pending_.erase(pending_.begin() + static_cast<long>(next));
+        lock.unlock();
+        fn();
+        lock.lock();
+      }
+    }
+  }
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::vector<Entry> pending_;
+  bool stopping_ = false;
+  std::thread worker_;
+};
+
+}  // namespace latencylab
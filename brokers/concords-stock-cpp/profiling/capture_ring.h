@@ -0,0 +1,223 @@
+/**
+ * In-process wire capture ring: packet-level evidence for outliers.
+ *
+ * tcpdump costs a copy per frame into the kernel's own ring and drops
+ * under exactly the load we care about; strace was a one-off. This ring
+ * lives inside the harness: the sockwatch interposer appends a bounded
+ * payload slice per send/recv into preallocated, pre-faulted memory, and
+ * nothing touches disk until Freeze() fires — then the ring is flushed
+ * as a pcapng file (LINKTYPE_USER0 frames, nanosecond timestamps from
+ * the probe clock, direction in epb_flags) and re-armed. Steady-state
+ * cost is one small memcpy into warm memory per syscall; every flushed
+ * file is the last N frames before its outlier.
+ *
+ * Fixed-size slots, overwriting oldest — the same shape as the log ring
+ * (log_ring.h) rather than a variable-length byte ring, so a frame is
+ * one slot claim and one bounded copy. pcapng framing is generated at
+ * flush time, off the hot path. Frames are written against a single
+ * pcapng interface; the capture is per-process, which for the probes
+ * means the one gRPC channel.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sys/uio.h>
+
+namespace latencylab {
+
+class CaptureRing {
+ public:
+  // Preallocate `bytes` of slot memory with `snaplen`-byte payload
+  // slices; flushes go to <prefix>_NNNN.pcapng. Memory is touched up
+  // front so steady-state appends never page-fault.
+  bool Configure(const char* prefix, size_t bytes, uint32_t snaplen) {
+    if (!prefix || bytes == 0 || snaplen == 0 ||
+        strlen(prefix) >= sizeof(prefix_)) {
+      return false;
+    }
+    strcpy(prefix_, prefix);
+    snaplen_ = snaplen;
+    stride_ = (sizeof(SlotMeta) + snaplen + 7) & ~size_t{7};
+    slot_count_ = bytes / stride_;
+    if (slot_count_ == 0) {
+      return false;
+    }
+    slots_ = std::make_unique<char[]>(slot_count_ * stride_);
+    memset(slots_.get(), 0, slot_count_ * stride_);
+    configured_ = true;
+    return true;
+  }
+
+  bool Configured() const { return configured_; }
+
+  // One frame: claim the next slot, copy up to snaplen bytes. Dropped
+  // (not blocked) while a flush is writing the previous outlier out.
+  void Append(bool outbound, int fd, const void* data, size_t len,
+              uint64_t ts_ns) {
+    struct iovec iov;
+    iov.iov_base = const_cast<void*>(data);
+    iov.iov_len = len;
+    AppendIov(outbound, fd, &iov, 1, len, ts_ns);
+  }
+
+  // Same, gathering from an iovec array (sendmsg/recvmsg); `len` is the
+  // syscall's return — the bytes actually on the wire.
+  void AppendIov(bool outbound, int fd, const struct iovec* iov, size_t iovcnt,
+                 size_t len, uint64_t ts_ns) {
+    if (!configured_) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frozen_) {
+      return;
+    }
+    char* slot = slots_.get() + (appended_ % slot_count_) * stride_;
+    appended_++;
+    SlotMeta* meta = reinterpret_cast<SlotMeta*>(slot);
+    meta->ts_ns = ts_ns;
+    meta->orig_len = static_cast<uint32_t>(len);
+    meta->fd = static_cast<uint16_t>(fd);
+    meta->outbound = outbound ? 1 : 0;
+
+    char* payload = slot + sizeof(SlotMeta);
+    uint32_t copied = 0;
+    for (size_t i = 0; i < iovcnt && copied < snaplen_ && copied < len; i++) {
+      uint32_t budget = snaplen_ - copied;
+      uint32_t remaining = static_cast<uint32_t>(len) - copied;
+      uint32_t take = static_cast<uint32_t>(iov[i].iov_len);
+      if (take > budget) take = budget;
+      if (take > remaining) take = remaining;
+      memcpy(payload + copied, iov[i].iov_base, take);
+      copied += take;
+    }
+    meta->cap_len = copied;
+  }
+
+  // Stop the ring, flush every held frame as pcapng, clear and re-arm
+  // for the next outlier. Runs on the caller's thread (the callback
+  // thread that just stamped the outlier — already off the timed path).
+  // The lock is only held to flip frozen_ and to re-arm: while frozen_
+  // is set appenders drop at the flag check without touching the slots,
+  // so the file write runs unlocked and the interposed send/recv threads
+  // never wait behind disk I/O.
+  void Freeze() {
+    uint64_t appended;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!configured_ || frozen_ || appended_ == 0) {
+        return;
+      }
+      frozen_ = true;
+      appended = appended_;
+    }
+
+    Flush(appended);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    appended_ = 0;
+    frozen_ = false;
+  }
+
+ private:
+  struct SlotMeta {
+    uint64_t ts_ns = 0;
+    uint32_t cap_len = 0;
+    uint32_t orig_len = 0;
+    uint16_t fd = 0;
+    uint8_t outbound = 0;
+    uint8_t reserved = 0;
+  };
+
+  void PutU16(FILE* f, uint16_t v) { fwrite(&v, sizeof(v), 1, f); }
+  void PutU32(FILE* f, uint32_t v) { fwrite(&v, sizeof(v), 1, f); }
+  void PutU64(FILE* f, uint64_t v) { fwrite(&v, sizeof(v), 1, f); }
+
+  // Called with frozen_ set and the mutex released; the slots are
+  // quiescent until Freeze() re-arms.
+  void Flush(uint64_t appended) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s_%04u.pcapng", prefix_, ++file_index_);
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+      fprintf(stderr, "sockwatch: cannot write capture %s\n", path);
+      return;
+    }
+
+    // Section Header Block.
+    PutU32(f, 0x0A0D0D0A);
+    PutU32(f, 28);
+    PutU32(f, 0x1A2B3C4D);
+    PutU16(f, 1);
+    PutU16(f, 0);
+    PutU64(f, 0xFFFFFFFFFFFFFFFFull);  // section length unknown
+    PutU32(f, 28);
+
+    // Interface Description Block: LINKTYPE_USER0 payload slices,
+    // if_tsresol = 9 (nanoseconds, matching the probe clock).
+    PutU32(f, 1);
+    PutU32(f, 32);
+    PutU16(f, 147);  // LINKTYPE_USER0
+    PutU16(f, 0);
+    PutU32(f, snaplen_);
+    PutU16(f, 9);  // if_tsresol
+    PutU16(f, 1);
+    fputc(9, f);
+    fputc(0, f);
+    fputc(0, f);
+    fputc(0, f);
+    PutU32(f, 0);  // opt_endofopt
+    PutU32(f, 32);
+
+    uint64_t first = appended > slot_count_ ? appended - slot_count_ : 0;
+    for (uint64_t i = first; i < appended; i++) {
+      const char* slot = slots_.get() + (i % slot_count_) * stride_;
+      const SlotMeta* meta = reinterpret_cast<const SlotMeta*>(slot);
+      uint32_t padded = (meta->cap_len + 3) & ~3u;
+      uint32_t block_len = 4 + 4 + 20 + padded + 12 + 4;
+
+      // Enhanced Packet Block with the direction in epb_flags.
+      PutU32(f, 6);
+      PutU32(f, block_len);
+      PutU32(f, 0);  // interface id
+      PutU32(f, static_cast<uint32_t>(meta->ts_ns >> 32));
+      PutU32(f, static_cast<uint32_t>(meta->ts_ns));
+      PutU32(f, meta->cap_len);
+      PutU32(f, meta->orig_len);
+      fwrite(slot + sizeof(SlotMeta), 1, meta->cap_len, f);
+      for (uint32_t p = meta->cap_len; p < padded; p++) fputc(0, f);
+      PutU16(f, 2);  // epb_flags
+      PutU16(f, 4);
+      PutU32(f, meta->outbound ? 2u : 1u);
+      PutU32(f, 0);  // opt_endofopt
+      PutU32(f, block_len);
+    }
+    fclose(f);
+
+    uint64_t frames = appended - first;
+    fprintf(stderr, "sockwatch: froze capture, %llu frames -> %s\n",
+            static_cast<unsigned long long>(frames), path);
+  }
+
+  // Plain members only: the interposer configures this from a
+  // constructor-attribute function whose order against C++ dynamic
+  // initializers is unspecified, so the ring must be constant-initialized
+  // (same reason the wire log is).
+  bool configured_ = false;
+  char prefix_[256] = {};
+  uint32_t snaplen_ = 0;
+  size_t stride_ = 0;
+  size_t slot_count_ = 0;
+  std::unique_ptr<char[]> slots_;
+
+  std::mutex mutex_;
+  bool frozen_ = false;
+  uint64_t appended_ = 0;
+  uint32_t file_index_ = 0;
+};
+
+}  // namespace latencylab
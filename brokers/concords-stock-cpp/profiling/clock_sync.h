@@ -0,0 +1,95 @@
+/**
+ * Broker clock-offset tracking and one-way latency decomposition.
+ *
+ * Round trips cannot say whether a slow response was slow inbound, slow
+ * processing, or slow outbound. Every order exchange is also a clock
+ * sample: with local send time t1, the broker's server timestamp ts, and
+ * local receive time t2, the NTP single-stamp estimate is
+ *     offset = ts - (t1 + t2) / 2,    delay = t2 - t1,
+ * and as in NTP the samples taken under the lowest delay carry the least
+ * queueing noise, so the tracked offset is the estimate from the
+ * minimum-delay exchange in a sliding window. With the offset in hand a
+ * sample splits into outbound (t1 -> broker) and inbound (broker -> t2)
+ * halves.
+ *
+ * The stock-client's OrderSubmitResult does not surface the server
+ * timestamp today; the probe integration compiles in behind
+ * -DLATENCYLAB_SDK_SERVER_TS for an SDK build that exposes it (like the
+ * reserved kSerialize/kAckParse stage hooks). The estimator itself is
+ * SDK-free and fed by whatever carries a server stamp.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace latencylab {
+
+class ClockSync {
+ public:
+  // NTP uses an 8-deep clock filter; the broker path is one hop of HTTP/2
+  // so the same depth rides out transient queueing fine.
+  static constexpr int kFilterDepth = 8;
+
+  struct Split {
+    uint64_t outbound_ns = 0;
+    uint64_t inbound_ns = 0;
+  };
+
+  // Feed one exchange: local send, broker server stamp, local receive
+  // (all UNIX ns, server stamp in the broker's clock).
+  void AddExchange(uint64_t t_send_ns, uint64_t t_server_ns,
+                   uint64_t t_recv_ns) {
+    if (t_recv_ns <= t_send_ns) {
+      return;  // clock stepped mid-exchange; useless sample
+    }
+    Sample& slot = window_[next_ % kFilterDepth];
+    slot.offset_ns = static_cast<int64_t>(t_server_ns) -
+                     static_cast<int64_t>((t_send_ns + t_recv_ns) / 2);
+    slot.delay_ns = t_recv_ns - t_send_ns;
+    next_++;
+
+    // Re-pick the minimum-delay sample; the window is 8 entries, so a
+    // linear scan per exchange is nothing.
+    int count = next_ < kFilterDepth ? static_cast<int>(next_) : kFilterDepth;
+    int best = 0;
+    for (int i = 1; i < count; i++) {
+      if (window_[i].delay_ns < window_[best].delay_ns) best = i;
+    }
+    offset_ns_ = window_[best].offset_ns;
+    ready_ = true;
+  }
+
+  bool Ready() const { return ready_; }
+
+  // Local clock plus offset is broker time; positive means the broker's
+  // clock reads ahead of ours.
+  int64_t OffsetNs() const { return offset_ns_; }
+
+  // Decompose one exchange into directional halves using the tracked
+  // offset. Negative halves (offset error larger than the true one-way)
+  // clamp to zero rather than smearing into the other direction.
+  Split Decompose(uint64_t t_send_ns, uint64_t t_server_ns,
+                  uint64_t t_recv_ns) const {
+    Split split;
+    int64_t server_local_ns = static_cast<int64_t>(t_server_ns) - offset_ns_;
+    int64_t outbound = server_local_ns - static_cast<int64_t>(t_send_ns);
+    int64_t inbound = static_cast<int64_t>(t_recv_ns) - server_local_ns;
+    split.outbound_ns = outbound > 0 ? static_cast<uint64_t>(outbound) : 0;
+    split.inbound_ns = inbound > 0 ? static_cast<uint64_t>(inbound) : 0;
+    return split;
+  }
+
+ private:
+  struct Sample {
+    int64_t offset_ns = 0;
+    uint64_t delay_ns = 0;
+  };
+
+  Sample window_[kFilterDepth] = {};
+  uint64_t next_ = 0;
+  int64_t offset_ns_ = 0;
+  bool ready_ = false;
+};
+
+}  // namespace latencylab
@@ -0,0 +1,99 @@
+/**
+ * Completion signalling between SDK callback threads and the waiter.
+ *
+ * The callback side publishes a monotonically increasing sequence number;
+ * the waiter either blocks on a condition variable (default, cheap on CPU)
+ * or busy-polls the atomic with PAUSE (--spin, no futex wakeup or scheduler
+ * latency between response arrival and the waiter observing it). In spin
+ * mode Signal() is a single atomic increment — the callback thread never
+ * touches a mutex.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace latencylab {
+
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#else
+  std::this_thread::yield();
+#endif
+}
+
+// Pin the calling thread to one core so a spinning waiter does not migrate
+// (and does not fight the SDK callback thread for its core).
+inline bool PinThisThread(int core) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core, &set);
+  if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+    std::cerr << "Failed to pin thread to core " << core << std::endl;
+    return false;
+  }
+  return true;
+}
+
+class Completion {
+ public:
+  explicit Completion(bool spin) : spin_(spin) {}
+
+  // Callback side: publish one completion.
+  void Signal() noexcept {
+    seq_.fetch_add(1, std::memory_order_release);
+    if (!spin_) {
+      { std::lock_guard<std::mutex> lock(mtx_); }
+      cv_.notify_one();
+    }
+  }
+
+  // Waiter side: consume the next completion. Returns false on timeout; a
+  // timeout resynchronizes to the current sequence so a late signal from an
+  // abandoned cycle is not mistaken for the next one.
+  bool WaitNext(std::chrono::nanoseconds timeout) {
+    uint64_t target = consumed_ + 1;
+
+    if (spin_) {
+      auto deadline = std::chrono::steady_clock::now() + timeout;
+      uint32_t polls = 0;
+      while (seq_.load(std::memory_order_acquire) < target) {
+        CpuRelax();
+        // Check the clock every ~4K polls so the hot loop stays hot.
+        if ((++polls & 0xfff) == 0 &&
+            std::chrono::steady_clock::now() >= deadline) {
+          consumed_ = seq_.load(std::memory_order_acquire);
+          return false;
+        }
+      }
+      consumed_ = target;
+      return true;
+    }
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    bool ok = cv_.wait_for(lock, timeout, [&] {
+      return seq_.load(std::memory_order_acquire) >= target;
+    });
+    consumed_ = ok ? target : seq_.load(std::memory_order_acquire);
+    return ok;
+  }
+
+ private:
+  const bool spin_;
+  std::atomic<uint64_t> seq_{0};
+  uint64_t consumed_ = 0;  // waiter thread only
+  std::mutex mtx_;
+  std::condition_variable cv_;
+};
+
+}  // namespace latencylab
@@ -0,0 +1,93 @@
+/**
+ * Concords stock-client wrapped as a BrokerAdapter.
+ *
+ * Thin: the adapter owns an instrumented client and the prepared probe
+ * order, and translates the SDK result structs into the SDK-free ack
+ * types. Built from the usual [user] and [order] config sections, so a
+ * comparison config is a probe config plus [trading_hours].
+ */
+
+#pragma once
+
+#include <toml++/toml.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "stock-client/order.h"
+#include "stock-client/stock_client.h"
+
+#include "binary_log.h"
+#include "broker_adapter.h"
+#include "order_config.h"
+#include "order_template.h"
+#include "stage_timer.h"
+
+namespace latencylab {
+
+class ConcordsAdapter : public BrokerAdapter {
+ public:
+  ConcordsAdapter(std::unique_ptr<InstrumentedStockClient<ProbeTiming>> client,
+                  PreparedOrder prepared)
+      : client_(std::move(client)), prepared_(std::move(prepared)) {}
+
+  const char* Name() const override { return "concords"; }
+  uint32_t BrokerId() const override { return kBrokerIdConcords; }
+
+  bool Connect() override { return client_->Connect(); }
+  bool Login() override { return client_->Login(); }
+  bool IsConnected() override { return client_->IsConnected(); }
+  void Disconnect() override { client_->Disconnect(); }
+
+  void SubmitProbeOrder() override { client_->SubmitOrder(prepared_.order()); }
+
+  void CancelProbeOrder(const std::string& order_id,
+                        const std::string& order_ticket_id) override {
+    client_->CancelOrder(order_id, order_ticket_id, prepared_.order());
+  }
+
+  void SetSubmitCallback(
+      std::function<void(const BrokerSubmitAck&)> callback) override {
+    client_->SetOrderSubmitCallback(
+        [callback = std::move(callback)](
+            const concordsapi::stockclient::OrderSubmitResult& result) {
+          BrokerSubmitAck ack;
+          ack.success = result.success;
+          ack.order_id = result.order_id;
+          ack.order_ticket_id = result.order_ticket_id;
+          ack.error_message = result.error_message;
+          callback(ack);
+        });
+  }
+
+  void SetCancelCallback(
+      std::function<void(const BrokerCancelAck&)> callback) override {
+    client_->SetOrderCancelCallback(
+        [callback = std::move(callback)](
+            const concordsapi::stockclient::OrderCancelResult& result) {
+          BrokerCancelAck ack;
+          ack.success = result.success;
+          ack.error_message = result.error_message;
+          callback(ack);
+        });
+  }
+
+ private:
+  std::unique_ptr<InstrumentedStockClient<ProbeTiming>> client_;
+  PreparedOrder prepared_;
+};
+
+inline std::unique_ptr<BrokerAdapter> MakeConcordsAdapter(
+    const toml::table& config) {
+  ClientCredentials creds = LoadCredentials(config["user"]);
+  auto client = std::make_unique<InstrumentedStockClient<ProbeTiming>>(
+      concordsapi::stockclient::BuildStockClient(
+          creds.user_id.c_str(), creds.password.c_str(), creds.account.c_str(),
+          creds.pfx_filepath.c_str(), creds.pfx_password.c_str()));
+  return std::make_unique<ConcordsAdapter>(std::move(client),
+                                           BuildPreparedOrder(config));
+}
+
+}  // namespace latencylab
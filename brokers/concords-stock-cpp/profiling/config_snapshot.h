@@ -0,0 +1,198 @@
+/**
+ * Precompiled binary config snapshots for fast probe startup.
+ *
+ * Market-open restarts relaunch dozens of probe containers at once, and
+ * each one pays for toml++ parsing plus a dozen string lookups before it
+ * touches the network. `--compile-config` validates the TOML once (the
+ * usual RequireString and enum-parser checks, same exit-on-bad-value
+ * behavior) and emits
+ * a versioned fixed-layout snapshot with the enums already resolved; a
+ * probe handed the snapshot loads it with one read() and zero parsing.
+ *
+ * The snapshot carries the flat hot core — [user] credentials and the
+ * base [order] — which is everything the ten startup lookups cover. The
+ * optional sections ([matrix], [rtt], [report], [regime]) stay TOML-only;
+ * pass a .toml when you need them.
+ */
+
+#pragma once
+
+#include <toml++/toml.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "order_config.h"
+#include "order_template.h"
+
+namespace latencylab {
+
+constexpr uint32_t kSnapshotMagic = 0x5343'4c4c;  // "LLCS"
+constexpr uint16_t kSnapshotVersion = 1;
+
+// Fixed layout, enums stored as their uint8_t values. Bump
+// kSnapshotVersion on any change; the loader rejects mismatches rather
+// than guessing.
+struct ConfigSnapshot {
+  uint32_t magic = kSnapshotMagic;
+  uint16_t version = kSnapshotVersion;
+  uint16_t reserved = 0;
+
+  char user_id[64] = {};
+  char password[64] = {};
+  char account[64] = {};
+  char pfx_filepath[128] = {};
+  char pfx_password[64] = {};
+
+  uint8_t market = 0;
+  uint8_t order_board = 0;
+  uint8_t funding_type = 0;
+  uint8_t side = 0;
+  uint8_t order_type = 0;
+  uint8_t time_in_force = 0;
+  uint8_t daytrade_shortsell = 0;
+  uint8_t order_reserved = 0;
+  char symbol[16] = {};
+  char quantity[16] = {};
+  char price[16] = {};
+};
+
+static_assert(std::is_trivially_copyable_v<ConfigSnapshot>,
+              "snapshot must load with a single read()");
+
+namespace detail {
+
+// Bounded copy; a credential that does not fit the snapshot field is a
+// config error, not something to truncate silently.
+template <size_t N>
+inline bool SnapshotCopy(char (&dst)[N], const std::string& src,
+                         const char* what) {
+  if (src.size() >= N) {
+    std::cerr << what << " too long for snapshot (" << src.size() << " >= "
+              << N << ")" << std::endl;
+    return false;
+  }
+  std::memcpy(dst, src.c_str(), src.size() + 1);
+  return true;
+}
+
+}  // namespace detail
+
+// Validate the parsed TOML through the usual loaders and write the
+// snapshot. Bad enum values exit via Parse* exactly as a probe run would.
+inline bool CompileConfig(const toml::table& config, const char* path) {
+  ConfigSnapshot snap;
+
+  ClientCredentials creds = LoadCredentials(config["user"]);
+  if (!detail::SnapshotCopy(snap.user_id, creds.user_id, "user_id") ||
+      !detail::SnapshotCopy(snap.password, creds.password, "password") ||
+      !detail::SnapshotCopy(snap.account, creds.account, "account") ||
+      !detail::SnapshotCopy(snap.pfx_filepath, creds.pfx_filepath,
+                            "pfx_filepath") ||
+      !detail::SnapshotCopy(snap.pfx_password, creds.pfx_password,
+                            "pfx_password")) {
+    return false;
+  }
+
+  auto order = config["order"];
+  snap.market = static_cast<uint8_t>(
+      ParseMarket(RequireString(order["market"], "[order].market")));
+  snap.order_board = static_cast<uint8_t>(ParseOrderBoard(
+      RequireString(order["order_board"], "[order].order_board")));
+  snap.funding_type = static_cast<uint8_t>(ParseFundingType(
+      RequireString(order["funding_type"], "[order].funding_type")));
+  snap.side = static_cast<uint8_t>(
+      ParseSide(RequireString(order["side"], "[order].side")));
+  snap.order_type = static_cast<uint8_t>(
+      ParseOrderType(RequireString(order["order_type"], "[order].order_type")));
+  snap.time_in_force = static_cast<uint8_t>(ParseTimeInForce(
+      RequireString(order["time_in_force"], "[order].time_in_force")));
+  snap.daytrade_shortsell = static_cast<uint8_t>(ParseDaytradeShortSell(
+      RequireString(order["daytrade_shortsell"], "[order].daytrade_shortsell")));
+  if (!detail::SnapshotCopy(snap.symbol,
+                            RequireString(order["symbol"], "[order].symbol"),
+                            "symbol") ||
+      !detail::SnapshotCopy(
+          snap.quantity, RequireString(order["quantity"], "[order].quantity"),
+          "quantity") ||
+      !detail::SnapshotCopy(snap.price,
+                            RequireString(order["price"], "[order].price"),
+                            "price")) {
+    return false;
+  }
+
+  FILE* f = fopen(path, "wb");
+  if (!f) {
+    std::cerr << "Cannot write snapshot: " << path << std::endl;
+    return false;
+  }
+  bool ok = fwrite(&snap, sizeof(snap), 1, f) == 1;
+  fclose(f);
+  if (!ok) {
+    std::cerr << "Short write to snapshot: " << path << std::endl;
+  }
+  return ok;
+}
+
+// Cheap sniff so probes can accept either format under --config: reads
+// the first four bytes and compares against the magic.
+inline bool IsSnapshotFile(const char* path) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    return false;
+  }
+  uint32_t magic = 0;
+  bool ok = fread(&magic, sizeof(magic), 1, f) == 1;
+  fclose(f);
+  return ok && magic == kSnapshotMagic;
+}
+
+// Single-read load; the snapshot is its own validation (magic, version,
+// exact size), everything else was checked at compile time.
+inline bool ReadSnapshot(const char* path, ConfigSnapshot& out) {
+  FILE* f = fopen(path, "rb");
+  if (!f) {
+    std::cerr << "Cannot open snapshot: " << path << std::endl;
+    return false;
+  }
+  bool ok = fread(&out, sizeof(out), 1, f) == 1 && fgetc(f) == EOF;
+  fclose(f);
+  if (!ok || out.magic != kSnapshotMagic) {
+    std::cerr << "Not a config snapshot: " << path << std::endl;
+    return false;
+  }
+  if (out.version != kSnapshotVersion) {
+    std::cerr << "Snapshot version " << out.version << " != "
+              << kSnapshotVersion << "; recompile with --compile-config"
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+inline ClientCredentials CredentialsFromSnapshot(const ConfigSnapshot& snap) {
+  ClientCredentials creds;
+  creds.user_id = snap.user_id;
+  creds.password = snap.password;
+  creds.account = snap.account;
+  creds.pfx_filepath = snap.pfx_filepath;
+  creds.pfx_password = snap.pfx_password;
+  return creds;
+}
+
+inline PreparedOrder OrderFromSnapshot(const ConfigSnapshot& snap) {
+  using namespace concordsapi::stockclient;
+  return PreparedOrder(static_cast<Market>(snap.market),
+                       static_cast<OrderBoard>(snap.order_board),
+                       static_cast<FundingType>(snap.funding_type),
+                       snap.symbol, static_cast<Side>(snap.side),
+                       static_cast<OrderType>(snap.order_type),
+                       static_cast<TimeInForce>(snap.time_in_force),
+                       snap.quantity, snap.price,
+                       static_cast<DaytradeShortSell>(snap.daytrade_shortsell));
+}
+
+}  // namespace latencylab
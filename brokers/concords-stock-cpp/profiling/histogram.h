@@ -0,0 +1,124 @@
+/**
+ * Fixed-memory log-bucketed latency histogram (HDR style).
+ *
+ * Values are binned by power-of-two magnitude with 32 linear sub-buckets per
+ * magnitude, giving ~3% relative error over 1ns..2^63ns in a flat 2K-entry
+ * array. Record() is a couple of shifts plus relaxed atomic increments, so
+ * it is safe to call from the SDK callback thread without adding jitter.
+ * Snapshots walk the buckets and are taken off the measurement path.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+
+namespace latencylab {
+
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 5;  // 32 sub-buckets per magnitude
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kBuckets = 64 * kSubBuckets;
+
+  struct Snapshot {
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t max_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+  };
+
+  void Record(uint64_t value_ns) noexcept {
+    counts_[BucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t seen = min_ns_.load(std::memory_order_relaxed);
+    while (value_ns < seen &&
+           !min_ns_.compare_exchange_weak(seen, value_ns,
+                                          std::memory_order_relaxed)) {
+    }
+    seen = max_ns_.load(std::memory_order_relaxed);
+    while (value_ns > seen &&
+           !max_ns_.compare_exchange_weak(seen, value_ns,
+                                          std::memory_order_relaxed)) {
+    }
+  }
+
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+
+  Snapshot TakeSnapshot() const {
+    Snapshot snap;
+    snap.count = count_.load(std::memory_order_relaxed);
+    if (snap.count == 0) return snap;
+    snap.min_ns = min_ns_.load(std::memory_order_relaxed);
+    snap.max_ns = max_ns_.load(std::memory_order_relaxed);
+    snap.p50_ns = ValueAtQuantile(snap.count, 0.50);
+    snap.p90_ns = ValueAtQuantile(snap.count, 0.90);
+    snap.p99_ns = ValueAtQuantile(snap.count, 0.99);
+    snap.p999_ns = ValueAtQuantile(snap.count, 0.999);
+    return snap;
+  }
+
+  void Print(std::ostream& os, const char* label) const {
+    Snapshot snap = TakeSnapshot();
+    os << label << ": n=" << snap.count;
+    if (snap.count > 0) {
+      os << " min=" << ToMs(snap.min_ns) << "ms"
+         << " p50=" << ToMs(snap.p50_ns) << "ms"
+         << " p90=" << ToMs(snap.p90_ns) << "ms"
+         << " p99=" << ToMs(snap.p99_ns) << "ms"
+         << " p99.9=" << ToMs(snap.p999_ns) << "ms"
+         << " max=" << ToMs(snap.max_ns) << "ms";
+    }
+    os << std::endl;
+  }
+
+  void Reset() {
+    for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    min_ns_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_ns_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  static int BucketIndex(uint64_t value) {
+    if (value < kSubBuckets) return static_cast<int>(value);
+    int magnitude = 63 - __builtin_clzll(value);
+    uint64_t sub = (value >> (magnitude - kSubBucketBits)) & (kSubBuckets - 1);
+    return magnitude * kSubBuckets + static_cast<int>(sub);
+  }
+
+  // Lower bound of a bucket; good to ~3% which is plenty for ms-scale RTTs.
+  static uint64_t BucketValue(int index) {
+    if (index < kSubBuckets) return static_cast<uint64_t>(index);
+    int magnitude = index >> kSubBucketBits;
+    uint64_t sub = index & (kSubBuckets - 1);
+    return (1ULL << magnitude) | (sub << (magnitude - kSubBucketBits));
+  }
+
+  uint64_t ValueAtQuantile(uint64_t total, double q) const {
+    uint64_t target = static_cast<uint64_t>(q * total);
+    if (target >= total) target = total - 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; i++) {
+      seen += counts_[i].load(std::memory_order_relaxed);
+      if (seen > target) return BucketValue(i);
+    }
+    return max_ns_.load(std::memory_order_relaxed);
+  }
+
+  static double ToMs(uint64_t ns) {
+    return static_cast<double>(ns / 1000) / 1000.0;
+  }
+
+  std::atomic<uint64_t> counts_[kBuckets] = {};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> min_ns_{UINT64_MAX};
+  std::atomic<uint64_t> max_ns_{0};
+};
+
+}  // namespace latencylab
@@ -0,0 +1,296 @@
+/**
+ * Streaming analyzer: SubmitOrder.md-style reports from binary logs.
+ *
+ * mmaps one or more log files (multi-day captures included — records are
+ * streamed once at memory bandwidth, nothing is loaded into per-record
+ * objects) and emits the Markdown/mermaid report format of SubmitOrder.md:
+ * per-stage and per-variant percentile tables, submit latency by time of
+ * day, and the send/recv timeline of a selected order as both a table and
+ * a sequence diagram.
+ *
+ * Like log_reader this builds without the stock-client tree:
+ *     g++ -std=c++20 -O2 log_analyzer.cpp -o log_analyzer
+ *
+ * Usage:
+ *     ./log_analyzer latency.bin [more.bin ...] [--tod-bin-minutes 60]
+ *                    [--timeline <timestamp_ns>] > report.md
+ *
+ * Timestamps are probe-clock UNIX nanoseconds; time-of-day bins use
+ * Taiwan time (UTC+8), matching the trading-hours configs. The flags of
+ * kSubmitTotal records are grouped as variant/session ids whenever more
+ * than one distinct value appears.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "binary_log.h"
+#include "histogram.h"
+#include "stages.h"
+
+using latencylab::LatencyHistogram;
+using latencylab::LogHeader;
+using latencylab::LogRecord;
+using latencylab::Stage;
+using latencylab::StageName;
+
+constexpr int64_t kTaiwanOffsetSeconds = 8 * 3600;
+
+struct MappedLog {
+  std::string path;
+  const LogHeader* header = nullptr;
+  const LogRecord* records = nullptr;
+  uint64_t count = 0;
+  void* base = nullptr;
+  size_t length = 0;
+};
+
+bool MapLog(const char* path, MappedLog& out) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    fprintf(stderr, "Cannot open %s\n", path);
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(LogHeader)) {
+    fprintf(stderr, "%s: too small for a log header\n", path);
+    close(fd);
+    return false;
+  }
+  void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    fprintf(stderr, "%s: mmap failed\n", path);
+    return false;
+  }
+  const LogHeader* header = static_cast<const LogHeader*>(base);
+  if (header->magic != latencylab::kLogMagic) {
+    fprintf(stderr, "%s: bad magic\n", path);
+    munmap(base, st.st_size);
+    return false;
+  }
+  out.path = path;
+  out.header = header;
+  out.records = reinterpret_cast<const LogRecord*>(
+      static_cast<const char*>(base) + sizeof(LogHeader));
+  uint64_t available =
+      (static_cast<size_t>(st.st_size) - sizeof(LogHeader)) / sizeof(LogRecord);
+  out.count = std::min(header->record_count, available);
+  out.base = base;
+  out.length = st.st_size;
+  return true;
+}
+
+double ToMs(uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+void PrintPercentileRow(const char* label, const LatencyHistogram& hist) {
+  auto snap = hist.TakeSnapshot();
+  if (snap.count == 0) return;
+  printf("| %s | %llu | %.3f | %.3f | %.3f | %.3f | %.3f | %.3f |\n", label,
+         static_cast<unsigned long long>(snap.count), ToMs(snap.min_ns),
+         ToMs(snap.p50_ns), ToMs(snap.p90_ns), ToMs(snap.p99_ns),
+         ToMs(snap.p999_ns), ToMs(snap.max_ns));
+}
+
+// Column headers and separator after the caller's label column.
+const char* PercentileHeader() {
+  return "| Count | Min | p50 | p90 | p99 | p99.9 | Max |\n"
+         "| --- | ----- | --- | --- | --- | --- | ----- | --- |";
+}
+
+void EmitTimeline(const std::vector<MappedLog>& logs, uint64_t target_ns) {
+  // Find the submit record nearest the requested timestamp, then every
+  // record inside its window.
+  const LogRecord* submit = nullptr;
+  for (const auto& log : logs) {
+    for (uint64_t i = 0; i < log.count; i++) {
+      const LogRecord& r = log.records[i];
+      if (r.stage_id != static_cast<uint16_t>(Stage::kSubmitTotal)) continue;
+      if (!submit ||
+          (r.timestamp_ns >= target_ns ? r.timestamp_ns - target_ns
+                                       : target_ns - r.timestamp_ns) <
+              (submit->timestamp_ns >= target_ns
+                   ? submit->timestamp_ns - target_ns
+                   : target_ns - submit->timestamp_ns)) {
+        submit = &r;
+      }
+    }
+  }
+  if (!submit) {
+    fprintf(stderr, "No submit records for --timeline\n");
+    return;
+  }
+  uint64_t begin = submit->timestamp_ns;
+  uint64_t end = begin + submit->duration_ns;
+
+  std::vector<const LogRecord*> window;
+  for (const auto& log : logs) {
+    for (uint64_t i = 0; i < log.count; i++) {
+      const LogRecord& r = log.records[i];
+      if (r.timestamp_ns >= begin && r.timestamp_ns <= end) {
+        window.push_back(&r);
+      }
+    }
+  }
+  std::sort(window.begin(), window.end(),
+            [](const LogRecord* a, const LogRecord* b) {
+              return a->timestamp_ns < b->timestamp_ns;
+            });
+
+  printf("## Order Timeline\n\n");
+  printf("Submit at %llu, total %.3fms.\n\n",
+         static_cast<unsigned long long>(begin), ToMs(submit->duration_ns));
+  printf("| Time (ms) | Event | Size | Description |\n");
+  printf("| --------- | ----- | ---- | ----------- |\n");
+  for (const LogRecord* r : window) {
+    Stage stage = static_cast<Stage>(r->stage_id);
+    const char* size = "-";
+    char size_buf[32];
+    if (stage == Stage::kWireSend || stage == Stage::kWireRecv) {
+      snprintf(size_buf, sizeof(size_buf), "%llu bytes",
+               static_cast<unsigned long long>(r->duration_ns));
+      size = size_buf;
+    }
+    printf("| %.3f | %s | %s | |\n", ToMs(r->timestamp_ns - begin),
+           StageName(stage), size);
+  }
+  printf("\n```mermaid\nsequenceDiagram\n");
+  printf("    participant SDK\n    participant Endpoint\n\n");
+  for (const LogRecord* r : window) {
+    Stage stage = static_cast<Stage>(r->stage_id);
+    if (stage == Stage::kWireSend) {
+      printf("    SDK->>Endpoint: %llu bytes\n",
+             static_cast<unsigned long long>(r->duration_ns));
+      printf("    Note left of SDK: +%.3fms\n", ToMs(r->timestamp_ns - begin));
+    } else if (stage == Stage::kWireRecv) {
+      printf("    Endpoint-->>SDK: %llu bytes\n",
+             static_cast<unsigned long long>(r->duration_ns));
+      printf("    Note left of SDK: +%.3fms\n", ToMs(r->timestamp_ns - begin));
+    }
+  }
+  printf("```\n\n");
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<const char*> paths;
+  int tod_bin_minutes = 60;
+  uint64_t timeline_ns = 0;
+  bool want_timeline = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--tod-bin-minutes") == 0 && i + 1 < argc) {
+      tod_bin_minutes = atoi(argv[++i]);
+      if (tod_bin_minutes <= 0 || tod_bin_minutes > 24 * 60) {
+        fprintf(stderr, "Invalid time-of-day bin: %s\n", argv[i]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--timeline") == 0 && i + 1 < argc) {
+      timeline_ns = strtoull(argv[++i], nullptr, 10);
+      want_timeline = true;
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty()) {
+    fprintf(stderr,
+            "Usage: %s <log.bin> [more.bin ...] [--tod-bin-minutes N] "
+            "[--timeline <timestamp_ns>]\n",
+            argv[0]);
+    return 1;
+  }
+
+  std::vector<MappedLog> logs;
+  for (const char* path : paths) {
+    MappedLog log;
+    if (!MapLog(path, log)) return 1;
+    logs.push_back(log);
+  }
+
+  // Single streaming pass: per-stage, per-variant and time-of-day
+  // histograms all fill from the same record read.
+  auto stage_hists = std::make_unique<
+      LatencyHistogram[]>(static_cast<size_t>(Stage::kStageCount));
+  std::map<uint16_t, std::unique_ptr<LatencyHistogram>> variant_hists;
+  // Round up: a bin width that does not divide 1440 leaves a short final
+  // bin, and minute 1439 must still index inside the allocation.
+  int tod_bins = (24 * 60 + tod_bin_minutes - 1) / tod_bin_minutes;
+  auto tod_hists = std::make_unique<LatencyHistogram[]>(tod_bins);
+
+  for (const auto& log : logs) {
+    for (uint64_t i = 0; i < log.count; i++) {
+      const LogRecord& r = log.records[i];
+      if (r.stage_id >= static_cast<uint16_t>(Stage::kStageCount)) continue;
+      stage_hists[r.stage_id].Record(r.duration_ns);
+      if (r.stage_id == static_cast<uint16_t>(Stage::kSubmitTotal)) {
+        auto& hist = variant_hists[r.flags];
+        if (!hist) hist = std::make_unique<LatencyHistogram>();
+        hist->Record(r.duration_ns);
+
+        int64_t seconds_of_day =
+            (static_cast<int64_t>(r.timestamp_ns / 1000000000ull) +
+             kTaiwanOffsetSeconds) %
+            86400;
+        tod_hists[seconds_of_day / 60 / tod_bin_minutes].Record(r.duration_ns);
+      }
+    }
+  }
+
+  printf("# Latency Report\n\n");
+  printf("## Sources\n\n");
+  printf("| File | Broker | Records | Dropped |\n");
+  printf("| ---- | ------ | ------- | ------- |\n");
+  for (const auto& log : logs) {
+    printf("| %s | %u | %llu | %llu |\n", log.path.c_str(),
+           log.header->broker_id, static_cast<unsigned long long>(log.count),
+           static_cast<unsigned long long>(log.header->dropped));
+  }
+  printf("\n## Per-Stage Percentiles (ms)\n\n| Stage %s\n",
+         PercentileHeader());
+  for (int s = 0; s < static_cast<int>(Stage::kStageCount); s++) {
+    PrintPercentileRow(StageName(static_cast<Stage>(s)), stage_hists[s]);
+  }
+
+  if (variant_hists.size() > 1) {
+    printf("\n## Per-Variant Submit Percentiles (ms)\n\n| Variant %s\n",
+           PercentileHeader());
+    for (const auto& [variant, hist] : variant_hists) {
+      char label[16];
+      snprintf(label, sizeof(label), "%u", variant);
+      PrintPercentileRow(label, *hist);
+    }
+  }
+
+  printf("\n## Submit Latency by Time of Day (UTC+8)\n\n| Window %s\n",
+         PercentileHeader());
+  for (int b = 0; b < tod_bins; b++) {
+    if (tod_hists[b].Count() == 0) continue;
+    int start_minutes = b * tod_bin_minutes;
+    int end_minutes = start_minutes + tod_bin_minutes;
+    if (end_minutes > 24 * 60) end_minutes = 24 * 60;  // short final bin
+    char label[32];
+    snprintf(label, sizeof(label), "%02d:%02d-%02d:%02d", start_minutes / 60,
+             start_minutes % 60, end_minutes / 60, end_minutes % 60);
+    PrintPercentileRow(label, tod_hists[b]);
+  }
+  printf("\n");
+
+  if (want_timeline) {
+    EmitTimeline(logs, timeline_ns);
+  }
+
+  for (auto& log : logs) {
+    munmap(log.base, log.length);
+  }
+  return 0;
+}
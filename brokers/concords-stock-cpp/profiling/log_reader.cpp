@@ -0,0 +1,73 @@
+/**
+ * Dump a binary latency log to CSV.
+ *
+ * Usage:
+ *     ./log_reader latency.bin > samples.csv
+ *
+ * Safe to run against a live log: only records up to the published
+ * record_count are emitted.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "binary_log.h"
+#include "stages.h"
+
+using namespace latencylab;
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <latency.bin>" << std::endl;
+    return 1;
+  }
+
+  FILE* f = fopen(argv[1], "rb");
+  if (!f) {
+    std::cerr << "Cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+
+  LogHeader header;
+  if (fread(&header, sizeof(header), 1, f) != 1) {
+    std::cerr << "Truncated header in " << argv[1] << std::endl;
+    fclose(f);
+    return 1;
+  }
+  if (header.magic != kLogMagic) {
+    std::cerr << "Bad magic in " << argv[1] << std::endl;
+    fclose(f);
+    return 1;
+  }
+  if (header.version != kLogVersion ||
+      header.record_size != sizeof(LogRecord)) {
+    std::cerr << "Unsupported log version " << header.version << std::endl;
+    fclose(f);
+    return 1;
+  }
+
+  std::cout << "timestamp_ns,broker_id,stage,duration_ns,flags\n";
+
+  uint64_t count = header.record_count;
+  LogRecord rec;
+  for (uint64_t i = 0; i < count; i++) {
+    if (fread(&rec, sizeof(rec), 1, f) != 1) {
+      std::cerr << "Truncated record " << i << " of " << count << std::endl;
+      break;
+    }
+    std::cout << rec.timestamp_ns << "," << rec.broker_id << ","
+              << StageName(static_cast<Stage>(rec.stage_id)) << ","
+              << rec.duration_ns << "," << rec.flags << "\n";
+  }
+
+  if (header.dropped > 0) {
+    std::cerr << "Warning: " << header.dropped
+              << " records were dropped (log full)" << std::endl;
+  }
+
+  fclose(f);
+  return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * Lock-free SPSC rings between measurement threads and one log writer.
+ *
+ * Even a memory-mapped Append touches shared log state, and with the
+ * scheduler, prober and SDK callback threads all producing records the
+ * single-writer assumption in BinaryLog no longer holds in-process. Each
+ * producing thread now gets its own fixed single-producer ring on first
+ * use; a dedicated writer thread drains every ring in batches and is the
+ * only thing that touches the mapped file. The producer path is one
+ * record copy and one release store — log pressure can never back up into
+ * the measurement, it can only drop (counted) records.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+#include "binary_log.h"
+#include "stages.h"
+
+namespace latencylab {
+
+class LogRingWriter {
+ public:
+  // Power of two; 4096 records (~96KB) per ring rides out multi-second
+  // writer stalls at any rate the probes reach.
+  static constexpr uint64_t kRingSize = 4096;
+  // Submit thread, SDK callback thread, cancel scheduler, RTT prober, and
+  // headroom.
+  static constexpr int kMaxProducers = 8;
+
+  explicit LogRingWriter(BinaryLog& log) : log_(log) {}
+
+  ~LogRingWriter() { Stop(); }
+
+  LogRingWriter(const LogRingWriter&) = delete;
+  LogRingWriter& operator=(const LogRingWriter&) = delete;
+
+  void Start() {
+    stop_.store(false, std::memory_order_relaxed);
+    writer_ = std::thread([this] { Run(); });
+  }
+
+  // Joins the writer after a final drain; safe to call twice.
+  void Stop() {
+    if (!writer_.joinable()) {
+      return;
+    }
+    stop_.store(true, std::memory_order_relaxed);
+    writer_.join();
+    DrainAll();
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped > 0) {
+      std::cerr << "Log ring dropped " << dropped << " records" << std::endl;
+    }
+  }
+
+  bool IsOpen() const { return log_.IsOpen(); }
+
+  // Producer path. First call on a thread claims it a ring; afterwards a
+  // sample costs one slot write and one release store. Never blocks: a
+  // full ring (stalled writer) drops the record and counts it.
+  void Append(Stage stage, uint64_t timestamp_ns, uint64_t duration_ns,
+              uint16_t flags = 0) noexcept {
+    // One writer per probe process; thread_local keeps ring lookup free.
+    static thread_local Ring* my_ring = nullptr;
+    if (!my_ring) {
+      my_ring = ClaimRing();
+      if (!my_ring) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    Ring& ring = *my_ring;
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= kRingSize) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    LogRecord& slot = ring.slots[head & (kRingSize - 1)];
+    slot.timestamp_ns = timestamp_ns;
+    slot.duration_ns = duration_ns;
+    slot.stage_id = static_cast<uint16_t>(stage);
+    slot.flags = flags;
+    ring.head.store(head + 1, std::memory_order_release);
+  }
+
+  uint64_t Dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Ring {
+    LogRecord slots[kRingSize];
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+  };
+
+  Ring* ClaimRing() {
+    int index = ring_count_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= kMaxProducers) {
+      std::cerr << "Log ring: more than " << kMaxProducers
+                << " producer threads, extra records dropped" << std::endl;
+      return nullptr;
+    }
+    return &rings_[index];
+  }
+
+  void Run() {
+    while (!stop_.load(std::memory_order_relaxed)) {
+      if (DrainAll() == 0) {
+        // Idle: sampling is seconds apart in daemon mode; 1ms keeps burst
+        // drain latency bounded without a hot spin.
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  // Batch-drains every claimed ring; returns records written.
+  uint64_t DrainAll() {
+    uint64_t drained = 0;
+    int count = ring_count_.load(std::memory_order_relaxed);
+    if (count > kMaxProducers) count = kMaxProducers;
+    for (int i = 0; i < count; i++) {
+      Ring& ring = rings_[i];
+      uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+      uint64_t head = ring.head.load(std::memory_order_acquire);
+      for (; tail != head; tail++) {
+        const LogRecord& slot = ring.slots[tail & (kRingSize - 1)];
+        log_.Append(static_cast<Stage>(slot.stage_id), slot.timestamp_ns,
+                    slot.duration_ns, slot.flags);
+        drained++;
+      }
+      ring.tail.store(tail, std::memory_order_release);
+    }
+    return drained;
+  }
+
+  BinaryLog& log_;
+  Ring rings_[kMaxProducers];
+  std::atomic<int> ring_count_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<bool> stop_{false};
+  std::thread writer_;
+};
+
+}  // namespace latencylab
@@ -0,0 +1,196 @@
+/**
+ * Mock StockClient: deterministic latency injection for off-hours runs.
+ *
+ * Implements the stock-client interface — same BuildStockClient factory,
+ * same callbacks — with ACKs replayed from a configurable latency model on
+ * a background thread. Linking this object file instead of the vendor
+ * library turns every probe (one-shot, daemon, burst, multi-session) into
+ * a harness-overhead benchmark that runs at any hour and any rate.
+ *
+ * Build (in place of -lstock-client):
+ *     g++ -std=c++20 -O2 -c mock_stock_client.cpp
+ *     g++ -std=c++20 -O2 submit_order.cpp mock_stock_client.o -lpthread ...
+ *
+ * Configured by environment, like the sockwatch shim:
+ *     MOCK_LATENCY_MODE   fixed (default) | lognormal | trace
+ *     MOCK_LATENCY_NS     fixed mode: injected latency (default 3000000)
+ *     MOCK_LATENCY_MU     lognormal mode: mu of ln(ns) (default 14.9)
+ *     MOCK_LATENCY_SIGMA  lognormal mode: sigma (default 0.35)
+ *     MOCK_TRACE          trace mode: binary log whose kSubmitTotal
+ *                         durations are replayed in order, cyclically
+ *     MOCK_SEED           RNG seed (default 1)
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "stock-client/order.h"
+#include "stock-client/stock_client.h"
+
+#include "binary_log.h"
+#include "cancel_scheduler.h"
+#include "stages.h"
+
+namespace concordsapi {
+namespace stockclient {
+
+namespace {
+
+using latencylab::LogHeader;
+using latencylab::LogRecord;
+using latencylab::Stage;
+
+// Injected ACK latency source; Next() is called on the submit thread but
+// only ever from one thread at a time, matching the real SDK's serial
+// submission path.
+class LatencyModel {
+ public:
+  LatencyModel() {
+    const char* mode = getenv("MOCK_LATENCY_MODE");
+    const char* seed = getenv("MOCK_SEED");
+    rng_.seed(seed ? strtoull(seed, nullptr, 10) : 1);
+
+    if (mode && strcmp(mode, "lognormal") == 0) {
+      const char* mu = getenv("MOCK_LATENCY_MU");
+      const char* sigma = getenv("MOCK_LATENCY_SIGMA");
+      lognormal_ = std::lognormal_distribution<double>(
+          mu ? atof(mu) : 14.9, sigma ? atof(sigma) : 0.35);
+      mode_ = Mode::kLognormal;
+    } else if (mode && strcmp(mode, "trace") == 0) {
+      const char* trace = getenv("MOCK_TRACE");
+      if (!trace || !LoadTrace(trace)) {
+        std::cerr << "mock: trace mode needs MOCK_TRACE pointing at a "
+                     "binary log with kSubmitTotal records"
+                  << std::endl;
+        exit(1);
+      }
+      mode_ = Mode::kTrace;
+    } else {
+      const char* ns = getenv("MOCK_LATENCY_NS");
+      fixed_ns_ = ns ? strtoull(ns, nullptr, 10) : 3000000;
+      mode_ = Mode::kFixed;
+    }
+  }
+
+  uint64_t Next() {
+    switch (mode_) {
+      case Mode::kFixed:
+        return fixed_ns_;
+      case Mode::kLognormal:
+        return static_cast<uint64_t>(lognormal_(rng_));
+      case Mode::kTrace:
+        return trace_[trace_next_++ % trace_.size()];
+    }
+    return fixed_ns_;
+  }
+
+ private:
+  enum class Mode { kFixed, kLognormal, kTrace };
+
+  bool LoadTrace(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+      return false;
+    }
+    LogHeader header = {};
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != latencylab::kLogMagic) {
+      fclose(file);
+      return false;
+    }
+    LogRecord record = {};
+    while (fread(&record, sizeof(record), 1, file) == 1) {
+      if (record.stage_id == static_cast<uint16_t>(Stage::kSubmitTotal)) {
+        trace_.push_back(record.duration_ns);
+      }
+    }
+    fclose(file);
+    return !trace_.empty();
+  }
+
+  Mode mode_ = Mode::kFixed;
+  uint64_t fixed_ns_ = 3000000;
+  std::lognormal_distribution<double> lognormal_;
+  std::mt19937_64 rng_;
+  std::vector<uint64_t> trace_;
+  size_t trace_next_ = 0;
+};
+
+class MockStockClient : public StockClient {
+ public:
+  bool Connect() override { return connected_ = true; }
+  bool Login() override { return true; }
+  bool IsConnected() override { return connected_; }
+  void Disconnect() override { connected_ = false; }
+
+  void SubmitOrder(const OrderInfo&) override {
+    uint64_t delay_ns = model_.Next();
+    uint64_t seq = next_order_++;
+    dispatcher_.ScheduleAfter(std::chrono::nanoseconds(delay_ns),
+                              [this, seq] {
+                                OrderSubmitResult result;
+                                result.success = true;
+                                char buf[32];
+                                snprintf(buf, sizeof(buf), "M%08llu",
+                                         static_cast<unsigned long long>(seq));
+                                result.order_id = buf;
+                                snprintf(buf, sizeof(buf), "T%08llu",
+                                         static_cast<unsigned long long>(seq));
+                                result.order_ticket_id = buf;
+                                if (submit_callback_) {
+                                  submit_callback_(result);
+                                }
+                              });
+  }
+
+  void CancelOrder(const std::string&, const std::string&,
+                   const OrderInfo&) override {
+    uint64_t delay_ns = model_.Next();
+    dispatcher_.ScheduleAfter(std::chrono::nanoseconds(delay_ns), [this] {
+      OrderCancelResult result;
+      result.success = true;
+      if (cancel_callback_) {
+        cancel_callback_(result);
+      }
+    });
+  }
+
+  void SetOrderSubmitCallback(
+      std::function<void(const OrderSubmitResult&)> callback) override {
+    submit_callback_ = std::move(callback);
+  }
+
+  void SetOrderCancelCallback(
+      std::function<void(const OrderCancelResult&)> callback) override {
+    cancel_callback_ = std::move(callback);
+  }
+
+ private:
+  bool connected_ = false;
+  uint64_t next_order_ = 1;
+  LatencyModel model_;
+  // The dispatcher thread plays the SDK callback thread: ACKs fire on it
+  // after the injected delay, never on the submitting thread.
+  latencylab::CancelScheduler dispatcher_;
+  std::function<void(const OrderSubmitResult&)> submit_callback_;
+  std::function<void(const OrderCancelResult&)> cancel_callback_;
+};
+
+}  // namespace
+
+// Credentials are accepted and ignored so probe configs work unchanged.
+std::unique_ptr<StockClient> BuildStockClient(const char*, const char*,
+                                              const char*, const char*,
+                                              const char*) {
+  return std::make_unique<MockStockClient>();
+}
+
+}  // namespace stockclient
+}  // namespace concordsapi
@@ -0,0 +1,249 @@
+/**
+ * Multi-session benchmark engine: N StockClient sessions in one process.
+ *
+ * One container per probe costs ~256MB and a runtime per session and makes
+ * cross-session comparisons depend on container clock skew. This engine
+ * owns every session in a single process — one clock, one binary log — and
+ * drives each from its own pinned thread with staggered submissions, so
+ * interleaved load shows whether the Frontend serializes per-connection.
+ *
+ * Config: the shared [order] section plus a [[clients]] array of tables,
+ * each with the same fields as [user] (user_id, password, account,
+ * pfx_filepath, pfx_password).
+ *
+ * Usage:
+ *     ./multi_client --config multi_config.toml --cycles 100 --interval 10
+ *                    [--stagger-ms 50] [--core-base N] [--spin]
+ *                    [--log latency.bin]
+ */
+
+#include <toml++/toml.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stock-client/order.h"
+#include "stock-client/stock_client.h"
+
+#include "binary_log.h"
+#include "completion.h"
+#include "histogram.h"
+#include "log_ring.h"
+#include "order_config.h"
+#include "order_template.h"
+#include "stage_timer.h"
+#include "tsc_clock.h"
+
+using namespace concordsapi::stockclient;
+
+using latencylab::BinaryLog;
+using latencylab::Completion;
+using latencylab::InstrumentedStockClient;
+using latencylab::LatencyHistogram;
+using latencylab::LogRingWriter;
+using latencylab::PreparedOrder;
+using latencylab::ProbeClock;
+using latencylab::ProbeTiming;
+using latencylab::Stage;
+
+// Every session's callback thread produces records; the ring writer is
+// the only thing that touches the mapped file.
+BinaryLog g_latency_log;
+LogRingWriter g_log_writer(g_latency_log);
+
+std::atomic<bool> g_stop_requested{false};
+
+void handleStopSignal(int) { g_stop_requested = true; }
+
+// Everything one session needs; no state is shared between sessions except
+// the (lock-free) log.
+struct Session {
+  int index = 0;
+  std::unique_ptr<InstrumentedStockClient<ProbeTiming>> client;
+  std::unique_ptr<Completion> submit_done;
+  std::unique_ptr<Completion> cancel_done;
+  LatencyHistogram histogram;
+  char order_id[32] = {};
+  char order_ticket_id[32] = {};
+  uint64_t start_ns = 0;
+};
+
+void runSession(Session& session, const OrderInfo& order_info, int cycles,
+                int interval_seconds, int stagger_ms, int core_base) {
+  if (core_base >= 0) {
+    latencylab::PinThisThread(core_base + session.index);
+  }
+
+  // Stagger session starts so submissions interleave instead of arriving
+  // in lockstep.
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(session.index * stagger_ms));
+
+  for (int cycle = 0; cycle < cycles && !g_stop_requested; cycle++) {
+    session.start_ns = ProbeClock::NowNs();
+    session.client->SubmitOrder(order_info);
+
+    if (!session.submit_done->WaitNext(std::chrono::seconds(10))) {
+      std::cerr << "session " << session.index << ": submit timeout"
+                << std::endl;
+      continue;
+    }
+
+    if (session.order_id[0] != '\0') {
+      session.client->CancelOrder(session.order_id, session.order_ticket_id,
+                                  order_info);
+      if (!session.cancel_done->WaitNext(std::chrono::seconds(10))) {
+        std::cerr << "session " << session.index << ": cancel timeout"
+                  << std::endl;
+      }
+    }
+
+    for (int waited = 0; waited < interval_seconds && !g_stop_requested;
+         waited++) {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const char* config_path = "multi_config.toml";
+  const char* log_path = nullptr;
+  int cycles = 100;
+  int interval_seconds = 10;
+  int stagger_ms = 50;
+  int core_base = -1;
+  bool spin_wait = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+      config_path = argv[++i];
+    } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+      log_path = argv[++i];
+    } else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+      cycles = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+      interval_seconds = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--stagger-ms") == 0 && i + 1 < argc) {
+      stagger_ms = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--core-base") == 0 && i + 1 < argc) {
+      core_base = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--spin") == 0) {
+      spin_wait = true;
+    }
+  }
+
+  ProbeClock::Calibrate();
+
+  auto config = toml::parse_file(config_path);
+  auto credentials = latencylab::LoadAllCredentials(config);
+  PreparedOrder prepared = latencylab::BuildPreparedOrder(config);
+  const OrderInfo& order_info = prepared.order();
+
+  if (log_path) {
+    if (!g_latency_log.Open(log_path, latencylab::kBrokerIdConcords,
+                            1 << 20)) {
+      return 1;
+    }
+    g_log_writer.Start();
+  }
+
+  signal(SIGINT, handleStopSignal);
+  signal(SIGTERM, handleStopSignal);
+
+  std::vector<std::unique_ptr<Session>> sessions;
+  for (size_t i = 0; i < credentials.size(); i++) {
+    const auto& creds = credentials[i];
+    auto session = std::make_unique<Session>();
+    session->index = static_cast<int>(i);
+    session->client = std::make_unique<InstrumentedStockClient<ProbeTiming>>(
+        BuildStockClient(creds.user_id.c_str(), creds.password.c_str(),
+                         creds.account.c_str(), creds.pfx_filepath.c_str(),
+                         creds.pfx_password.c_str()));
+    session->submit_done = std::make_unique<Completion>(spin_wait);
+    session->cancel_done = std::make_unique<Completion>(spin_wait);
+
+    Session* s = session.get();
+    s->client->SetOrderSubmitCallback([s](const OrderSubmitResult& result) {
+      uint64_t end_ns = ProbeClock::NowNs();
+      uint64_t total_ns = end_ns - s->start_ns;
+      s->histogram.Record(total_ns);
+      if (g_latency_log.IsOpen()) {
+        // Session index rides in the record flags.
+        g_log_writer.Append(Stage::kSubmitTotal, s->start_ns, total_ns,
+                            static_cast<uint16_t>(s->index));
+      }
+      s->order_id[0] = '\0';
+      if (result.success) {
+        strncpy(s->order_id, result.order_id.c_str(),
+                sizeof(s->order_id) - 1);
+        strncpy(s->order_ticket_id, result.order_ticket_id.c_str(),
+                sizeof(s->order_ticket_id) - 1);
+      } else {
+        std::cerr << "session " << s->index
+                  << ": submit failed: " << result.error_message << std::endl;
+      }
+      s->submit_done->Signal();
+    });
+    s->client->SetOrderCancelCallback([s](const OrderCancelResult& result) {
+      if (!result.success) {
+        std::cerr << "session " << s->index
+                  << ": cancel failed: " << result.error_message << std::endl;
+      }
+      s->cancel_done->Signal();
+    });
+
+    sessions.push_back(std::move(session));
+  }
+
+  // Connect/login serially: one session at a time keeps the broker's
+  // session setup path out of its own neighbours' measurements.
+  for (auto& session : sessions) {
+    if (!session->client->Connect()) {
+      std::cerr << "session " << session->index << ": failed to connect"
+                << std::endl;
+      return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    if (!session->client->Login()) {
+      std::cerr << "session " << session->index << ": failed to login"
+                << std::endl;
+      return 1;
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+  std::cerr << sessions.size() << " sessions connected and logged in"
+            << std::endl;
+
+  std::vector<std::thread> drivers;
+  drivers.reserve(sessions.size());
+  for (auto& session : sessions) {
+    Session* s = session.get();
+    drivers.emplace_back([s, &order_info, cycles, interval_seconds,
+                          stagger_ms, core_base] {
+      runSession(*s, order_info, cycles, interval_seconds, stagger_ms,
+                 core_base);
+    });
+  }
+  for (auto& t : drivers) {
+    t.join();
+  }
+
+  for (auto& session : sessions) {
+    std::string label = "session_" + std::to_string(session->index);
+    session->histogram.Print(std::cerr, label.c_str());
+    if (session->client->IsConnected()) {
+      session->client->Disconnect();
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * C++20 coroutine layer over the stock client.
+ *
+ * `co_await client.Submit(order)` suspends, issues the submit, and resumes
+ * directly on the SDK callback thread with the result — no mutex, condvar
+ * or atomic-flag handshake on the timed path; resumption cost replaces
+ * futex wakeup cost in every sample. One order lifecycle is one linear
+ * coroutine instead of a callback state machine.
+ *
+ * One submit and one cancel may be pending per client at a time, matching
+ * the serial probe lifecycle; the burst path keeps its slot table.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <utility>
+
+#include "stock-client/order.h"
+#include "stock-client/stock_client.h"
+
+#include "stage_timer.h"
+
+namespace latencylab {
+
+// Minimal detached task for probe coroutines: starts eagerly, cleans up
+// after itself. Completion is signalled by the coroutine body (the probes
+// already have Completion for that).
+struct ProbeTask {
+  struct promise_type {
+    ProbeTask get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+template <typename Policy>
+class AsyncStockClient {
+ public:
+  using Inner = InstrumentedStockClient<Policy>;
+
+  struct SubmitAwaiter {
+    AsyncStockClient& client;
+    const concordsapi::stockclient::OrderInfo& order;
+    concordsapi::stockclient::OrderSubmitResult result{};
+    std::coroutine_handle<> handle;
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> h) {
+      handle = h;
+      client.pending_submit_.store(this, std::memory_order_release);
+      client.inner_.SubmitOrder(order);
+    }
+
+    concordsapi::stockclient::OrderSubmitResult await_resume() {
+      return std::move(result);
+    }
+  };
+
+  struct CancelAwaiter {
+    AsyncStockClient& client;
+    std::string order_id;
+    std::string order_ticket_id;
+    const concordsapi::stockclient::OrderInfo& order;
+    concordsapi::stockclient::OrderCancelResult result{};
+    std::coroutine_handle<> handle;
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> h) {
+      handle = h;
+      client.pending_cancel_.store(this, std::memory_order_release);
+      client.inner_.CancelOrder(order_id, order_ticket_id, order);
+    }
+
+    concordsapi::stockclient::OrderCancelResult await_resume() {
+      return std::move(result);
+    }
+  };
+
+  explicit AsyncStockClient(Inner& inner) : inner_(inner) {
+    inner_.SetOrderSubmitCallback(
+        [this](const concordsapi::stockclient::OrderSubmitResult& r) {
+          auto* awaiter = static_cast<SubmitAwaiter*>(
+              pending_submit_.exchange(nullptr, std::memory_order_acq_rel));
+          if (awaiter) {
+            awaiter->result = r;
+            awaiter->handle.resume();  // on the SDK callback thread
+          }
+        });
+    inner_.SetOrderCancelCallback(
+        [this](const concordsapi::stockclient::OrderCancelResult& r) {
+          auto* awaiter = static_cast<CancelAwaiter*>(
+              pending_cancel_.exchange(nullptr, std::memory_order_acq_rel));
+          if (awaiter) {
+            awaiter->result = r;
+            awaiter->handle.resume();
+          }
+        });
+  }
+
+  SubmitAwaiter Submit(const concordsapi::stockclient::OrderInfo& order) {
+    return SubmitAwaiter{*this, order};
+  }
+
+  CancelAwaiter Cancel(std::string order_id, std::string order_ticket_id,
+                       const concordsapi::stockclient::OrderInfo& order) {
+    return CancelAwaiter{*this, std::move(order_id),
+                         std::move(order_ticket_id), order};
+  }
+
+  Inner& inner() { return inner_; }
+
+ private:
+  Inner& inner_;
+  std::atomic<void*> pending_submit_{nullptr};
+  std::atomic<void*> pending_cancel_{nullptr};
+};
+
+}  // namespace latencylab
@@ -0,0 +1,249 @@
+/**
+ * Shared TOML config parsing for the Concords probes.
+ *
+ * The enum parsers and order/credential loading used to live in
+ * submit_order.cpp; they are shared here so multi-session binaries read the
+ * same config format. Invalid values print the offending string and exit,
+ * as before — a probe with a bad config has nothing useful to measure.
+ */
+
+#pragma once
+
+#include <toml++/toml.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "stock-client/order.h"
+
+#include "order_template.h"
+
+namespace latencylab {
+
+inline concordsapi::stockclient::Market ParseMarket(const std::string& str) {
+  using concordsapi::stockclient::Market;
+  if (str == "TSE") return Market::TSE;
+  if (str == "OTC") return Market::OTC;
+  std::cerr << "Invalid market: " << str << std::endl;
+  exit(1);
+}
+
+inline concordsapi::stockclient::OrderBoard ParseOrderBoard(
+    const std::string& str) {
+  using concordsapi::stockclient::OrderBoard;
+  if (str == "RoundLot") return OrderBoard::RoundLot;
+  if (str == "OddLot") return OrderBoard::OddLot;
+  if (str == "PostMarket_Fixed") return OrderBoard::PostMarket_Fixed;
+  if (str == "PostMarket_OddLot") return OrderBoard::PostMarket_OddLot;
+  std::cerr << "Invalid order_board: " << str << std::endl;
+  exit(1);
+}
+
+inline concordsapi::stockclient::FundingType ParseFundingType(
+    const std::string& str) {
+  using concordsapi::stockclient::FundingType;
+  if (str == "Cash") return FundingType::Cash;
+  if (str == "MarginBuy") return FundingType::MarginBuy;
+  if (str == "MarginShortSell") return FundingType::MarginShortSell;
+  std::cerr << "Invalid funding_type: " << str << std::endl;
+  exit(1);
+}
+
+inline concordsapi::stockclient::Side ParseSide(const std::string& str) {
+  using concordsapi::stockclient::Side;
+  if (str == "Buy" || str == "B") return Side::Buy;
+  if (str == "Sell" || str == "S") return Side::Sell;
+  std::cerr << "Invalid side: " << str << std::endl;
+  exit(1);
+}
+
+inline concordsapi::stockclient::OrderType ParseOrderType(
+    const std::string& str) {
+  using concordsapi::stockclient::OrderType;
+  if (str == "Limit") return OrderType::Limit;
+  if (str == "Market") return OrderType::Market;
+  std::cerr << "Invalid order_type: " << str << std::endl;
+  exit(1);
+}
+
+inline concordsapi::stockclient::TimeInForce ParseTimeInForce(
+    const std::string& str) {
+  using concordsapi::stockclient::TimeInForce;
+  if (str == "ROD") return TimeInForce::ROD;
+  if (str == "IOC") return TimeInForce::IOC;
+  if (str == "FOK") return TimeInForce::FOK;
+  std::cerr << "Invalid time_in_force: " << str << std::endl;
+  exit(1);
+}
+
+inline concordsapi::stockclient::DaytradeShortSell ParseDaytradeShortSell(
+    const std::string& str) {
+  using concordsapi::stockclient::DaytradeShortSell;
+  if (str == "True" || str == "Y") return DaytradeShortSell::True;
+  if (str == "False" || str == "N") return DaytradeShortSell::False;
+  std::cerr << "Invalid daytrade_shortsell: " << str << std::endl;
+  exit(1);
+}
+
+inline std::string RequireString(const toml::node_view<const toml::node>& node,
+                                 const char* what) {
+  auto value = node.value<std::string>();
+  if (!value) {
+    std::cerr << "Missing required config: " << what << std::endl;
+    exit(1);
+  }
+  return *value;
+}
+
+// Build the immutable order template from the [order] section.
+inline PreparedOrder BuildPreparedOrder(const toml::table& config) {
+  auto order = config["order"];
+  return PreparedOrder(
+      ParseMarket(RequireString(order["market"], "[order].market")),
+      ParseOrderBoard(
+          RequireString(order["order_board"], "[order].order_board")),
+      ParseFundingType(
+          RequireString(order["funding_type"], "[order].funding_type")),
+      RequireString(order["symbol"], "[order].symbol"),
+      ParseSide(RequireString(order["side"], "[order].side")),
+      ParseOrderType(RequireString(order["order_type"], "[order].order_type")),
+      ParseTimeInForce(
+          RequireString(order["time_in_force"], "[order].time_in_force")),
+      RequireString(order["quantity"], "[order].quantity"),
+      RequireString(order["price"], "[order].price"),
+      ParseDaytradeShortSell(RequireString(order["daytrade_shortsell"],
+                                           "[order].daytrade_shortsell")));
+}
+
+// One entry in an A/B matrix sweep: the template plus a label naming the
+// fields that differ from the base order.
+struct OrderVariant {
+  std::string label;
+  PreparedOrder prepared;
+};
+
+// Cross product of the [matrix] lists over the base [order]. Any enum
+// field (market, order_board, funding_type, side, order_type,
+// time_in_force) may be a list in [matrix]; fields without a list come
+// from [order] as usual. Without a [matrix] section this returns the base
+// order as the single variant, so callers need no special case.
+//
+//     [matrix]
+//     time_in_force = ["ROD", "IOC"]
+//     order_board = ["RoundLot", "OddLot"]
+inline std::vector<OrderVariant> BuildOrderMatrix(const toml::table& config) {
+  auto order = config["order"];
+  auto matrix = config["matrix"];
+
+  // Swept values for one field, or the single base value. `swept` tells
+  // the label builder which fields to name.
+  auto values = [&](const char* key, bool& swept) {
+    std::vector<std::string> list;
+    if (const toml::array* arr = matrix[key].as_array()) {
+      for (const toml::node& node : *arr) {
+        if (auto str = node.value<std::string>()) {
+          list.push_back(*str);
+        }
+      }
+    }
+    swept = list.size() > 1;
+    if (list.empty()) {
+      list.push_back(RequireString(order[key], key));
+    }
+    return list;
+  };
+
+  bool sweep_market, sweep_board, sweep_funding, sweep_side, sweep_type,
+      sweep_tif;
+  auto markets = values("market", sweep_market);
+  auto boards = values("order_board", sweep_board);
+  auto fundings = values("funding_type", sweep_funding);
+  auto sides = values("side", sweep_side);
+  auto types = values("order_type", sweep_type);
+  auto tifs = values("time_in_force", sweep_tif);
+
+  std::string symbol = RequireString(order["symbol"], "[order].symbol");
+  std::string quantity = RequireString(order["quantity"], "[order].quantity");
+  std::string price = RequireString(order["price"], "[order].price");
+  auto daytrade = ParseDaytradeShortSell(
+      RequireString(order["daytrade_shortsell"], "[order].daytrade_shortsell"));
+
+  std::vector<OrderVariant> variants;
+  for (const auto& market : markets) {
+    for (const auto& board : boards) {
+      for (const auto& funding : fundings) {
+        for (const auto& side : sides) {
+          for (const auto& type : types) {
+            for (const auto& tif : tifs) {
+              std::string label;
+              auto tag = [&label](bool swept, const std::string& value) {
+                if (!swept) return;
+                if (!label.empty()) label += "/";
+                label += value;
+              };
+              tag(sweep_market, market);
+              tag(sweep_board, board);
+              tag(sweep_funding, funding);
+              tag(sweep_side, side);
+              tag(sweep_type, type);
+              tag(sweep_tif, tif);
+              if (label.empty()) label = "base";
+              variants.push_back(
+                  {std::move(label),
+                   PreparedOrder(ParseMarket(market), ParseOrderBoard(board),
+                                 ParseFundingType(funding), symbol,
+                                 ParseSide(side), ParseOrderType(type),
+                                 ParseTimeInForce(tif), quantity, price,
+                                 daytrade)});
+            }
+          }
+        }
+      }
+    }
+  }
+  return variants;
+}
+
+struct ClientCredentials {
+  std::string user_id;
+  std::string password;
+  std::string account;
+  std::string pfx_filepath;
+  std::string pfx_password;
+};
+
+inline ClientCredentials LoadCredentials(
+    const toml::node_view<const toml::node>& user) {
+  ClientCredentials creds;
+  creds.user_id = RequireString(user["user_id"], "user_id");
+  creds.password = RequireString(user["password"], "password");
+  creds.account = RequireString(user["account"], "account");
+  creds.pfx_filepath = RequireString(user["pfx_filepath"], "pfx_filepath");
+  creds.pfx_password = RequireString(user["pfx_password"], "pfx_password");
+  return creds;
+}
+
+// One [user] table (single-session probes) or a [[clients]] array of
+// tables (multi-session engine).
+inline std::vector<ClientCredentials> LoadAllCredentials(
+    const toml::table& config) {
+  std::vector<ClientCredentials> all;
+  if (const toml::array* clients = config["clients"].as_array()) {
+    for (const toml::node& node : *clients) {
+      if (const toml::table* t = node.as_table()) {
+        all.push_back(LoadCredentials(toml::node_view<const toml::node>(*t)));
+      }
+    }
+  } else if (config.contains("user")) {
+    all.push_back(LoadCredentials(config["user"]));
+  }
+  if (all.empty()) {
+    std::cerr << "Config has neither [user] nor [[clients]]" << std::endl;
+    exit(1);
+  }
+  return all;
+}
+
+}  // namespace latencylab
@@ -0,0 +1,101 @@
+/**
+ * Prepared-order template: pay OrderInfo construction once at startup.
+ *
+ * OrderInfo copies four std::strings per construction, so building it inside
+ * the timed window measures our own request assembly, not the broker. A
+ * PreparedOrder is built once from the parsed config; each cycle reuses the
+ * same immutable OrderInfo, and the mutable fields (price, quantity) can be
+ * patched between cycles without allocation — the backing strings are
+ * reserved at fixed capacity up front, and the short numeric fields stay
+ * within SSO, so a patch is a character copy plus an in-place rebuild.
+ *
+ * Pre-serializing the protobuf bytes themselves (patching at fixed byte
+ * offsets) needs a serialized-submit entry point on the SDK; until the
+ * stock-client exposes one, bytes-ready-to-send starts at SubmitOrder().
+ */
+
+#pragma once
+
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "stock-client/order.h"
+
+namespace latencylab {
+
+class PreparedOrder {
+ public:
+  // Longest price/quantity strings we ever patch in; generous for TWSE
+  // tick formats and keeps patches inside preallocated storage.
+  static constexpr size_t kMaxFieldLen = 15;
+
+  PreparedOrder(concordsapi::stockclient::Market market,
+                concordsapi::stockclient::OrderBoard order_board,
+                concordsapi::stockclient::FundingType funding_type,
+                const std::string& symbol,
+                concordsapi::stockclient::Side side,
+                concordsapi::stockclient::OrderType order_type,
+                concordsapi::stockclient::TimeInForce time_in_force,
+                const std::string& quantity, const std::string& price,
+                concordsapi::stockclient::DaytradeShortSell daytrade_shortsell)
+      : market_(market),
+        order_board_(order_board),
+        funding_type_(funding_type),
+        symbol_(symbol),
+        side_(side),
+        order_type_(order_type),
+        time_in_force_(time_in_force),
+        quantity_(quantity),
+        price_(price),
+        daytrade_shortsell_(daytrade_shortsell) {
+    quantity_.reserve(kMaxFieldLen);
+    price_.reserve(kMaxFieldLen);
+    Rebuild();
+  }
+
+  // The template handed to SubmitOrder/CancelOrder each cycle.
+  const concordsapi::stockclient::OrderInfo& order() const { return *order_; }
+
+  // Patch a mutable field between cycles. Returns false (template
+  // unchanged) if the new value would not fit the reserved storage.
+  bool SetPrice(const char* price) {
+    if (strlen(price) > kMaxFieldLen) return false;
+    price_.assign(price);
+    Rebuild();
+    return true;
+  }
+
+  bool SetQuantity(const char* quantity) {
+    if (strlen(quantity) > kMaxFieldLen) return false;
+    quantity_.assign(quantity);
+    Rebuild();
+    return true;
+  }
+
+  const std::string& price() const { return price_; }
+  const std::string& quantity() const { return quantity_; }
+
+ private:
+  void Rebuild() {
+    order_.emplace(market_, order_board_, funding_type_, symbol_, side_,
+                   order_type_, time_in_force_, quantity_, price_,
+                   daytrade_shortsell_);
+  }
+
+  concordsapi::stockclient::Market market_;
+  concordsapi::stockclient::OrderBoard order_board_;
+  concordsapi::stockclient::FundingType funding_type_;
+  std::string symbol_;
+  concordsapi::stockclient::Side side_;
+  concordsapi::stockclient::OrderType order_type_;
+  concordsapi::stockclient::TimeInForce time_in_force_;
+  std::string quantity_;
+  std::string price_;
+  concordsapi::stockclient::DaytradeShortSell daytrade_shortsell_;
+
+  std::optional<concordsapi::stockclient::OrderInfo> order_;
+};
+
+}  // namespace latencylab
@@ -0,0 +1,75 @@
+/**
+ * Real-time scheduling helpers for the measurement threads.
+ *
+ * The probes share Docker hosts with 0.5-CPU limits; a preemption in the
+ * timed window is a multi-millisecond outlier indistinguishable from broker
+ * slowness. EnableRealtime() pins the calling thread and elevates it to
+ * SCHED_FIFO (memory is already wired by LockAllMemory()); CtxSwitchWatch
+ * counts the thread's involuntary context switches per sample so the
+ * contaminated ones can be flagged in the log and filtered out instead of
+ * poisoning the percentiles.
+ *
+ * SCHED_FIFO needs CAP_SYS_NICE or an rtprio rlimit; in compose that is
+ * cap_add: [SYS_NICE] plus ulimits.rtprio. Failure degrades with a warning
+ * rather than aborting — a best-effort probe still measures.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include "completion.h"
+
+namespace latencylab {
+
+// Pin the calling thread to `core` (skipped when negative) and raise it to
+// SCHED_FIFO. Returns whether the policy change took.
+inline bool EnableRealtime(int core, int priority = 80) {
+  if (core >= 0) {
+    PinThisThread(core);
+  }
+  sched_param param = {};
+  param.sched_priority = priority;
+  int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  if (rc != 0) {
+    std::cerr << "SCHED_FIFO unavailable (" << strerror(rc)
+              << "), thread stays SCHED_OTHER" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Per-thread involuntary context-switch counter (rusage nivcsw deltas).
+// Each instance belongs to exactly one thread; getrusage(RUSAGE_THREAD)
+// reads the calling thread's counters.
+class CtxSwitchWatch {
+ public:
+  // Baseline before the timed window.
+  void Begin() { last_ = ReadNivcsw(); }
+
+  // Involuntary switches since the last Begin()/Delta(); advances the
+  // baseline.
+  uint64_t Delta() {
+    uint64_t now = ReadNivcsw();
+    uint64_t delta = now - last_;
+    last_ = now;
+    return delta;
+  }
+
+ private:
+  static uint64_t ReadNivcsw() {
+    rusage usage = {};
+    getrusage(RUSAGE_THREAD, &usage);
+    return static_cast<uint64_t>(usage.ru_nivcsw);
+  }
+
+  uint64_t last_ = 0;
+};
+
+}  // namespace latencylab
@@ -0,0 +1,113 @@
+/**
+ * Online regime-change detection over the live TOTAL_NS stream.
+ *
+ * "Concords got slower 20 minutes ago" should page, not appear in
+ * tomorrow's report. The detector keeps a constant-memory quantile sketch
+ * (the same log-bucketed histogram the percentile printouts use) over a
+ * sliding window of samples; when a window closes, its p50/p99 are
+ * compared against the accepted baseline and a shift beyond the
+ * configured band is reported so the caller can annotate the log and
+ * warn. Record() is a couple of shifts and increments per sample — the
+ * bucket walk only happens on window boundaries, and the whole thing runs
+ * from the callback after the sample is already stamped, never on the
+ * timed path.
+ *
+ * Config ([regime] section of the probe config):
+ *     [regime]
+ *     window = 64       # samples per window
+ *     band_pct = 50     # flag when p50 or p99 moves more than this %
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "histogram.h"
+
+namespace latencylab {
+
+class RegimeDetector {
+ public:
+  struct Shift {
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t baseline_p50_ns = 0;
+    uint64_t baseline_p99_ns = 0;
+    // bit0: p50 crossed the band, bit1: p99 did. Matches the flags of the
+    // kRegimeShift record.
+    uint16_t trigger = 0;
+  };
+
+  void Configure(int window, double band_pct) {
+    window_ = window;
+    band_pct_ = band_pct;
+    enabled_ = window > 1 && band_pct > 0;
+  }
+
+  bool Enabled() const { return enabled_; }
+
+  // Feed one sample; returns the shift when this sample closed a window
+  // whose quantiles left the band. The first full window seeds the
+  // baseline silently.
+  std::optional<Shift> Record(uint64_t sample_ns) {
+    if (!enabled_) {
+      return std::nullopt;
+    }
+    current_.Record(sample_ns);
+    if (static_cast<int>(current_.Count()) < window_) {
+      return std::nullopt;
+    }
+
+    auto snap = current_.TakeSnapshot();
+    current_.Reset();
+
+    if (baseline_p50_ns_ == 0) {
+      baseline_p50_ns_ = snap.p50_ns;
+      baseline_p99_ns_ = snap.p99_ns;
+      return std::nullopt;
+    }
+
+    uint16_t trigger = 0;
+    if (OutsideBand(snap.p50_ns, baseline_p50_ns_)) trigger |= 1;
+    if (OutsideBand(snap.p99_ns, baseline_p99_ns_)) trigger |= 2;
+
+    if (trigger == 0) {
+      // Stable window: drift the baseline slowly so gradual intraday
+      // change does not accumulate into a false page.
+      baseline_p50_ns_ = (baseline_p50_ns_ * 3 + snap.p50_ns) / 4;
+      baseline_p99_ns_ = (baseline_p99_ns_ * 3 + snap.p99_ns) / 4;
+      return std::nullopt;
+    }
+
+    Shift shift;
+    shift.p50_ns = snap.p50_ns;
+    shift.p99_ns = snap.p99_ns;
+    shift.baseline_p50_ns = baseline_p50_ns_;
+    shift.baseline_p99_ns = baseline_p99_ns_;
+    shift.trigger = trigger;
+
+    // The new regime becomes the baseline: one page per shift, not one
+    // per window until the old level returns.
+    baseline_p50_ns_ = snap.p50_ns;
+    baseline_p99_ns_ = snap.p99_ns;
+    return shift;
+  }
+
+ private:
+  bool OutsideBand(uint64_t value, uint64_t baseline) const {
+    double ratio =
+        static_cast<double>(value) / static_cast<double>(baseline) - 1.0;
+    if (ratio < 0) ratio = -ratio;
+    return ratio * 100.0 > band_pct_;
+  }
+
+  bool enabled_ = false;
+  int window_ = 0;
+  double band_pct_ = 0;
+  LatencyHistogram current_;
+  uint64_t baseline_p50_ns_ = 0;
+  uint64_t baseline_p99_ns_ = 0;
+};
+
+}  // namespace latencylab
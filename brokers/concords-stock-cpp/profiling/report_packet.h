@@ -0,0 +1,35 @@
+/**
+ * Wire format for fire-and-forget UDP latency reports.
+ *
+ * One fixed 64-byte datagram per sample, little-endian, shared by the C++
+ * probes (udp_reporter.h), the Python probes (struct.pack with the same
+ * layout) and the collector service (collector/latency_collector.cpp).
+ * The payload mirrors a LogRecord plus the broker id and a short label, so
+ * the collector can append straight into the standard mapped-log format.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace latencylab {
+
+constexpr uint32_t kReportMagic = 0x5052'4c4c;  // "LLRP"
+constexpr uint16_t kReportVersion = 1;
+
+struct ReportPacket {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t stage_id;     // latencylab::Stage
+  uint32_t broker_id;    // kBrokerId*
+  uint16_t flags;        // producer context, as in LogRecord
+  uint16_t reserved;
+  uint64_t timestamp_ns; // producer clock, UNIX epoch
+  uint64_t duration_ns;
+  char label[32];        // symbol or probe tag, NUL-terminated, may be empty
+};
+
+static_assert(sizeof(ReportPacket) == 64,
+              "report packets are exactly one 64-byte datagram");
+
+}  // namespace latencylab
@@ -0,0 +1,194 @@
+/**
+ * Background RTT prober: continuous network weather next to order latency.
+ *
+ * SubmitOrder.md records one-off RTTs measured by hand (Endpoint 2.7ms,
+ * Midend 30ms); that cannot tell a broker-side p99 spike from the AWS
+ * Taipei link wobbling. One low-rate thread TCP-pings each configured
+ * target (time from connect() to SYN-ACK, then immediate close), keeps a
+ * ring of recent samples, and appends every sample to the binary log as a
+ * kRttProbe record. Probes run well off the measurement path — the only
+ * thing the callback thread ever touches is one relaxed atomic load.
+ *
+ * Config ([rtt] section of the probe config):
+ *     [rtt]
+ *     targets = ["endpoint.example.com:443", "midend.example.com:443"]
+ *     interval_ms = 500
+ */
+
+#pragma once
+
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log_ring.h"
+#include "stages.h"
+#include "tsc_clock.h"
+
+namespace latencylab {
+
+class RttProber {
+ public:
+  static constexpr size_t kRingSize = 64;
+
+  struct Target {
+    std::string host;
+    std::string port;
+    // Resolved once at Start(); DNS in the probe loop would measure the
+    // resolver, not the link.
+    sockaddr_storage addr = {};
+    socklen_t addr_len = 0;
+    int family = 0;
+    std::atomic<uint64_t> latest_ns{0};
+    uint64_t ring[kRingSize] = {};
+    size_t ring_next = 0;
+  };
+
+  RttProber() = default;
+  ~RttProber() { Stop(); }
+
+  RttProber(const RttProber&) = delete;
+  RttProber& operator=(const RttProber&) = delete;
+
+  // "host:port"; call before Start().
+  bool AddTarget(const std::string& spec) {
+    size_t colon = spec.rfind(':');
+    if (colon == std::string::npos || colon == 0 ||
+        colon + 1 == spec.size()) {
+      std::cerr << "Invalid RTT target (want host:port): " << spec
+                << std::endl;
+      return false;
+    }
+    auto target = std::make_unique<Target>();
+    target->host = spec.substr(0, colon);
+    target->port = spec.substr(colon + 1);
+    targets_.push_back(std::move(target));
+    return true;
+  }
+
+  // Resolves every target and launches the probe thread. `log` may be
+  // null; samples are then only available through LatestNs().
+  bool Start(LogRingWriter* log, int interval_ms) {
+    for (auto& target : targets_) {
+      addrinfo hints = {};
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+      addrinfo* result = nullptr;
+      int rc = getaddrinfo(target->host.c_str(), target->port.c_str(),
+                           &hints, &result);
+      if (rc != 0 || !result) {
+        std::cerr << "Cannot resolve RTT target " << target->host << ": "
+                  << gai_strerror(rc) << std::endl;
+        return false;
+      }
+      memcpy(&target->addr, result->ai_addr, result->ai_addrlen);
+      target->addr_len = result->ai_addrlen;
+      target->family = result->ai_family;
+      freeaddrinfo(result);
+    }
+
+    log_ = log;
+    interval_ms_ = interval_ms;
+    stop_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this] { Run(); });
+    return true;
+  }
+
+  void Stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  size_t TargetCount() const { return targets_.size(); }
+
+  // Most recent successful RTT for a target; 0 until the first sample.
+  uint64_t LatestNs(size_t index) const {
+    return targets_[index]->latest_ns.load(std::memory_order_relaxed);
+  }
+
+  // Latest RTT of target 0 (the Endpoint by convention) in microseconds,
+  // clamped to fit a LogRecord flags field. 65ms of headroom covers the
+  // 30-42ms RTTs in SubmitOrder.md with room for bad weather.
+  uint16_t LatestMicrosClamped() const {
+    if (targets_.empty()) return 0;
+    uint64_t us = LatestNs(0) / 1000;
+    return us > 0xffff ? 0xffff : static_cast<uint16_t>(us);
+  }
+
+ private:
+  void Run() {
+    while (!stop_.load(std::memory_order_relaxed)) {
+      for (size_t i = 0; i < targets_.size(); i++) {
+        uint64_t begin_ns = ProbeClock::NowNs();
+        uint64_t rtt_ns = ProbeOnce(*targets_[i]);
+        if (rtt_ns > 0) {
+          Target& target = *targets_[i];
+          target.ring[target.ring_next++ % kRingSize] = rtt_ns;
+          target.latest_ns.store(rtt_ns, std::memory_order_relaxed);
+          if (log_ && log_->IsOpen()) {
+            log_->Append(Stage::kRttProbe, begin_ns, rtt_ns,
+                         static_cast<uint16_t>(i));
+          }
+        }
+      }
+      // Sleep in small steps so Stop() is prompt even at long intervals.
+      for (int slept = 0;
+           slept < interval_ms_ && !stop_.load(std::memory_order_relaxed);
+           slept += 50) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      }
+    }
+  }
+
+  // Non-blocking connect; RTT is the time until the socket turns writable
+  // (SYN-ACK received). Returns 0 on failure/timeout.
+  static uint64_t ProbeOnce(const Target& target) {
+    int fd = socket(target.family, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+      return 0;
+    }
+
+    uint64_t begin_ns = ProbeClock::NowNs();
+    int rc = connect(fd, reinterpret_cast<const sockaddr*>(&target.addr),
+                     target.addr_len);
+    if (rc != 0 && errno != EINPROGRESS) {
+      close(fd);
+      return 0;
+    }
+
+    pollfd pfd = {fd, POLLOUT, 0};
+    rc = poll(&pfd, 1, 1000 /* ms */);
+    uint64_t end_ns = ProbeClock::NowNs();
+
+    int so_error = 0;
+    socklen_t len = sizeof(so_error);
+    bool connected = rc == 1 && (pfd.revents & POLLOUT) &&
+                     getsockopt(fd, SOL_SOCKET, SO_ERROR, &so_error, &len) ==
+                         0 &&
+                     so_error == 0;
+    close(fd);
+    return connected ? end_ns - begin_ns : 0;
+  }
+
+  std::vector<std::unique_ptr<Target>> targets_;
+  LogRingWriter* log_ = nullptr;
+  int interval_ms_ = 500;
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+}  // namespace latencylab
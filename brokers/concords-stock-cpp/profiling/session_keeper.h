@@ -0,0 +1,147 @@
+/**
+ * Resilient session layer: keep-alive monitoring, fast re-login, and
+ * outage accounting.
+ *
+ * A broker-side disconnect used to end the probe ("Failed to connect")
+ * or, on restart, repeat the full cold path — BuildStockClient re-parses
+ * the PFX and re-handshakes TLS — plus the fixed 1-second sleeps around
+ * Connect()/Login(). The keeper's first rule is therefore to keep the
+ * one client instance alive and drive Connect()/Login() on it again:
+ * certificate material and whatever TLS session state the SDK caches
+ * stay in process memory, and ticket reuse across reconnects is the
+ * SDK's to exploit because the object it would store tickets in
+ * survives. Readiness is polled at millisecond granularity instead of
+ * fixed sleeps (the SDK exposes no readiness callback to wait on), and
+ * daemon-mode recovery runs automatically with exponential backoff. The
+ * outage window lands in the binary log as a kSessionOutage record —
+ * samples lost to a drop become data instead of a dead process.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+#include "log_ring.h"
+#include "stages.h"
+#include "tsc_clock.h"
+
+namespace latencylab {
+
+// Client is the instrumented stock client (or any adapter with the same
+// Connect/Login/IsConnected/Disconnect surface).
+template <typename Client>
+class SessionKeeper {
+ public:
+  // `writer` may be null (no --log); outages are then cerr-only.
+  SessionKeeper(Client& client, LogRingWriter* writer)
+      : client_(client), writer_(writer) {}
+
+  ~SessionKeeper() { Stop(); }
+
+  // First connect+login. Replaces the fixed 1s sleeps with a 10ms
+  // readiness poll bounded by `timeout`, so a fast handshake proceeds as
+  // soon as the SDK reports connected.
+  bool EstablishFirst(
+      std::chrono::milliseconds timeout = std::chrono::seconds(10)) {
+    if (!client_.Connect()) {
+      return false;
+    }
+    if (!PollConnected(timeout)) {
+      return false;
+    }
+    if (!client_.Login()) {
+      return false;
+    }
+    ready_.store(true, std::memory_order_release);
+    return true;
+  }
+
+  bool Ready() const { return ready_.load(std::memory_order_acquire); }
+
+  // Daemon mode: watch the session and bridge drops with re-login.
+  // Detection granularity is poll_ms; the outage stamp carries it.
+  void StartMonitor(int poll_ms = 500) {
+    if (monitor_.joinable()) {
+      return;
+    }
+    stop_.store(false, std::memory_order_relaxed);
+    monitor_ = std::thread([this, poll_ms] { Run(poll_ms); });
+  }
+
+  void Stop() {
+    stop_.store(true, std::memory_order_relaxed);
+    if (monitor_.joinable()) {
+      monitor_.join();
+    }
+  }
+
+ private:
+  bool PollConnected(std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!client_.IsConnected()) {
+      if (std::chrono::steady_clock::now() >= deadline ||
+          stop_.load(std::memory_order_relaxed)) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+  }
+
+  void Run(int poll_ms) {
+    while (!stop_.load(std::memory_order_relaxed)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(poll_ms));
+      if (stop_.load(std::memory_order_relaxed) || client_.IsConnected()) {
+        continue;
+      }
+
+      uint64_t outage_begin_ns = ProbeClock::NowNs();
+      ready_.store(false, std::memory_order_release);
+      std::cerr << "Session dropped, re-logging in..." << std::endl;
+
+      // Exponential backoff: 100ms doubling to a 10s cap. The client is
+      // reused, not rebuilt, so each attempt skips the PFX parse.
+      uint32_t attempts = 0;
+      auto delay = std::chrono::milliseconds(100);
+      while (!stop_.load(std::memory_order_relaxed)) {
+        attempts++;
+        client_.Disconnect();
+        if (client_.Connect() &&
+            PollConnected(std::chrono::seconds(5)) && client_.Login()) {
+          break;
+        }
+        std::cerr << "Re-login attempt " << attempts << " failed, retrying in "
+                  << delay.count() << "ms" << std::endl;
+        std::this_thread::sleep_for(delay);
+        delay = std::min(delay * 2, std::chrono::milliseconds(10000));
+      }
+      if (stop_.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      uint64_t outage_ns = ProbeClock::NowNs() - outage_begin_ns;
+      ready_.store(true, std::memory_order_release);
+      if (writer_) {
+        writer_->Append(Stage::kSessionOutage, outage_begin_ns, outage_ns,
+                        attempts > 0xffff
+                            ? uint16_t{0xffff}
+                            : static_cast<uint16_t>(attempts));
+      }
+      std::cerr << "Session restored after " << (outage_ns / 1000000.0)
+                << "ms (" << attempts << " attempt"
+                << (attempts == 1 ? "" : "s") << ")" << std::endl;
+    }
+  }
+
+  Client& client_;
+  LogRingWriter* writer_;
+  std::atomic<bool> ready_{false};
+  std::atomic<bool> stop_{false};
+  std::thread monitor_;
+};
+
+}  // namespace latencylab
@@ -0,0 +1,300 @@
+/**
+ * LD_PRELOAD socket interposer: per-syscall wire timeline without strace.
+ *
+ * Timestamps every send/recv on the process's sockets into a binary log
+ * (see binary_log.h), reproducing the sendmsg/recvmsg timeline that
+ * SubmitOrder.md was hand-assembling from strace output — but at one
+ * ProbeClock read plus a mapped-memory append per syscall, with no ptrace
+ * stop, so it can stay on in production containers. Wire records use
+ * kWireSend/kWireRecv with the byte count in duration_ns and the fd in
+ * flags; dump them with log_reader like any other log.
+ *
+ * With SOCKWATCH_TIMESTAMPING=1 each socket additionally gets
+ * SO_TIMESTAMPING RX stamps: kWireRecvKernel (software, when the packet
+ * entered the stack) and kWireRecvHw (NIC, where supported) records are
+ * emitted next to the wire_recv record, with duration_ns carrying the lag
+ * until our recvmsg observed the data — the wire-arrival vs gRPC/SDK
+ * dispatch split.
+ *
+ * With SOCKWATCH_CAPTURE=<prefix> payload slices additionally go into an
+ * in-process capture ring (capture_ring.h) that flushes pcapng files
+ * only when the probe's outlier trigger calls sockwatch_capture_freeze()
+ * — packet-level evidence for every p99.9 outlier without tcpdump's
+ * per-frame copy or drops. SOCKWATCH_CAPTURE_MB (default 4) sizes the
+ * ring, SOCKWATCH_CAPTURE_SNAP (default 256) the per-frame slice.
+ *
+ * Build:
+ *     g++ -std=c++20 -O2 -shared -fPIC -o libsockwatch.so sockwatch.cpp
+ * Run:
+ *     SOCKWATCH_LOG=wire.bin LD_PRELOAD=./libsockwatch.so ./submit_order ...
+ */
+
+#include <dlfcn.h>
+#include <linux/net_tstamp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+#include "binary_log.h"
+#include "capture_ring.h"
+#include "stages.h"
+#include "tsc_clock.h"
+
+namespace {
+
+using latencylab::BinaryLog;
+using latencylab::CaptureRing;
+using latencylab::ProbeClock;
+using latencylab::Stage;
+
+BinaryLog g_wire_log;
+CaptureRing g_capture;
+std::atomic<bool> g_initialized{false};
+bool g_want_timestamping = false;
+
+// Per-fd socket test, cached so the interposed path does not re-ask the
+// kernel on every call. close() clears the slot.
+constexpr int kMaxFd = 4096;
+std::atomic<int8_t> g_fd_is_socket[kMaxFd];  // -1 unknown, 0 no, 1 yes
+
+using SendmsgFn = ssize_t (*)(int, const struct msghdr*, int);
+using RecvmsgFn = ssize_t (*)(int, struct msghdr*, int);
+using SendFn = ssize_t (*)(int, const void*, size_t, int);
+using RecvFn = ssize_t (*)(int, void*, size_t, int);
+using SendtoFn = ssize_t (*)(int, const void*, size_t, int,
+                             const struct sockaddr*, socklen_t);
+using RecvfromFn = ssize_t (*)(int, void*, size_t, int, struct sockaddr*,
+                               socklen_t*);
+using CloseFn = int (*)(int);
+
+SendmsgFn real_sendmsg;
+RecvmsgFn real_recvmsg;
+SendFn real_send;
+RecvFn real_recv;
+SendtoFn real_sendto;
+RecvfromFn real_recvfrom;
+CloseFn real_close;
+
+__attribute__((constructor)) void Init() {
+  real_sendmsg = reinterpret_cast<SendmsgFn>(dlsym(RTLD_NEXT, "sendmsg"));
+  real_recvmsg = reinterpret_cast<RecvmsgFn>(dlsym(RTLD_NEXT, "recvmsg"));
+  real_send = reinterpret_cast<SendFn>(dlsym(RTLD_NEXT, "send"));
+  real_recv = reinterpret_cast<RecvFn>(dlsym(RTLD_NEXT, "recv"));
+  real_sendto = reinterpret_cast<SendtoFn>(dlsym(RTLD_NEXT, "sendto"));
+  real_recvfrom = reinterpret_cast<RecvfromFn>(dlsym(RTLD_NEXT, "recvfrom"));
+  real_close = reinterpret_cast<CloseFn>(dlsym(RTLD_NEXT, "close"));
+
+  for (auto& s : g_fd_is_socket) s.store(-1, std::memory_order_relaxed);
+
+  const char* path = getenv("SOCKWATCH_LOG");
+  const char* capture_prefix = getenv("SOCKWATCH_CAPTURE");
+  if (!path && !capture_prefix) return;  // preloaded but idle
+
+  ProbeClock::Calibrate();
+  g_want_timestamping = getenv("SOCKWATCH_TIMESTAMPING") != nullptr;
+
+  if (capture_prefix) {
+    const char* mb = getenv("SOCKWATCH_CAPTURE_MB");
+    const char* snap = getenv("SOCKWATCH_CAPTURE_SNAP");
+    size_t bytes = static_cast<size_t>(mb ? atoi(mb) : 4) << 20;
+    uint32_t snaplen = snap ? static_cast<uint32_t>(atoi(snap)) : 256;
+    g_capture.Configure(capture_prefix, bytes, snaplen);
+  }
+
+  if (path) {
+    const char* broker = getenv("SOCKWATCH_BROKER_ID");
+    uint32_t broker_id = broker ? static_cast<uint32_t>(atoi(broker))
+                                : latencylab::kBrokerIdConcords;
+    if (g_wire_log.Open(path, broker_id, 1 << 20)) {
+      g_initialized.store(true, std::memory_order_release);
+    }
+  }
+}
+
+bool IsSocket(int fd) {
+  if (fd < 0 || fd >= kMaxFd) return false;
+  int8_t cached = g_fd_is_socket[fd].load(std::memory_order_relaxed);
+  if (cached >= 0) return cached == 1;
+  int type = 0;
+  socklen_t len = sizeof(type);
+  bool is_socket = getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len) == 0;
+  if (is_socket && g_want_timestamping) {
+    // First sight of this socket: ask for RX stamps. Harmless if the
+    // socket type does not support it.
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+                SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+    setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags));
+  }
+  g_fd_is_socket[fd].store(is_socket ? 1 : 0, std::memory_order_relaxed);
+  return is_socket;
+}
+
+uint64_t TimespecNs(const struct timespec& ts) {
+  return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL +
+         static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// Pull SCM_TIMESTAMPING out of a control buffer and emit the kernel/NIC
+// arrival records. ts[0] is software, ts[2] is raw hardware.
+void RecordRxTimestamps(int fd, const struct msghdr* msg, uint64_t now_ns) {
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(const_cast<struct msghdr*>(msg));
+       cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(msg), cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_TIMESTAMPING)
+      continue;
+    const struct timespec* ts =
+        reinterpret_cast<const struct timespec*>(CMSG_DATA(cmsg));
+    uint64_t sw_ns = TimespecNs(ts[0]);
+    uint64_t hw_ns = TimespecNs(ts[2]);
+    // The TSC-anchored probe clock can sit a few microseconds off
+    // CLOCK_REALTIME, so the stamp may appear to postdate now_ns; clamp
+    // the lag to zero rather than dropping the record, and only discard
+    // stamps more than a second out (clock step, bogus NIC time).
+    constexpr uint64_t kMaxSkewNs = 1'000'000'000ULL;
+    auto lag = [now_ns](uint64_t stamp) -> uint64_t {
+      return stamp < now_ns ? now_ns - stamp : 0;
+    };
+    auto plausible = [now_ns](uint64_t stamp) {
+      uint64_t diff = stamp < now_ns ? now_ns - stamp : stamp - now_ns;
+      return stamp != 0 && diff < kMaxSkewNs;
+    };
+    if (plausible(sw_ns)) {
+      g_wire_log.Append(Stage::kWireRecvKernel, sw_ns, lag(sw_ns),
+                        static_cast<uint16_t>(fd));
+    }
+    if (plausible(hw_ns)) {
+      g_wire_log.Append(Stage::kWireRecvHw, hw_ns, lag(hw_ns),
+                        static_cast<uint16_t>(fd));
+    }
+  }
+}
+
+void RecordWire(Stage stage, int fd, ssize_t bytes,
+                const void* buf = nullptr) {
+  if (bytes <= 0) return;
+  bool log_on = g_initialized.load(std::memory_order_acquire);
+  bool capture_on = g_capture.Configured();
+  if (!log_on && !capture_on) return;
+  if (!IsSocket(fd)) return;
+  uint64_t now_ns = ProbeClock::NowNs();
+  if (log_on) {
+    g_wire_log.Append(stage, now_ns, static_cast<uint64_t>(bytes),
+                      static_cast<uint16_t>(fd));
+  }
+  if (capture_on && buf) {
+    g_capture.Append(stage == Stage::kWireSend, fd, buf,
+                     static_cast<size_t>(bytes), now_ns);
+  }
+}
+
+// iovec flavour for sendmsg/recvmsg: the wire record is identical, the
+// capture gathers its slice across the vector.
+void RecordWireIov(Stage stage, int fd, ssize_t bytes, const struct iovec* iov,
+                   size_t iovcnt) {
+  if (bytes <= 0) return;
+  bool log_on = g_initialized.load(std::memory_order_acquire);
+  bool capture_on = g_capture.Configured();
+  if (!log_on && !capture_on) return;
+  if (!IsSocket(fd)) return;
+  uint64_t now_ns = ProbeClock::NowNs();
+  if (log_on) {
+    g_wire_log.Append(stage, now_ns, static_cast<uint64_t>(bytes),
+                      static_cast<uint16_t>(fd));
+  }
+  if (capture_on && iov) {
+    g_capture.AppendIov(stage == Stage::kWireSend, fd, iov, iovcnt,
+                        static_cast<size_t>(bytes), now_ns);
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+ssize_t sendmsg(int fd, const struct msghdr* msg, int flags) {
+  ssize_t n = real_sendmsg(fd, msg, flags);
+  RecordWireIov(Stage::kWireSend, fd, n, msg ? msg->msg_iov : nullptr,
+                msg ? msg->msg_iovlen : 0);
+  return n;
+}
+
+ssize_t recvmsg(int fd, struct msghdr* msg, int flags) {
+  // When RX timestamping is on and the caller did not ask for control
+  // data (gRPC does not), hand the kernel a shadow msghdr with our own
+  // cmsg buffer so the SCM_TIMESTAMPING stamps are not silently dropped.
+  bool capture = msg != nullptr && msg->msg_control == nullptr &&
+                 g_want_timestamping &&
+                 g_initialized.load(std::memory_order_acquire) &&
+                 IsSocket(fd);
+  if (!capture) {
+    ssize_t n = real_recvmsg(fd, msg, flags);
+    RecordWireIov(Stage::kWireRecv, fd, n, msg ? msg->msg_iov : nullptr,
+                  msg ? msg->msg_iovlen : 0);
+    return n;
+  }
+
+  struct msghdr shadow = *msg;
+  alignas(struct cmsghdr) char cbuf[256];
+  shadow.msg_control = cbuf;
+  shadow.msg_controllen = sizeof(cbuf);
+
+  ssize_t n = real_recvmsg(fd, &shadow, flags);
+  if (n > 0) {
+    uint64_t now_ns = ProbeClock::NowNs();
+    g_wire_log.Append(Stage::kWireRecv, now_ns, static_cast<uint64_t>(n),
+                      static_cast<uint16_t>(fd));
+    RecordRxTimestamps(fd, &shadow, now_ns);
+    if (g_capture.Configured()) {
+      g_capture.AppendIov(false, fd, shadow.msg_iov, shadow.msg_iovlen,
+                          static_cast<size_t>(n), now_ns);
+    }
+  }
+  // The caller never asked for control data; report flags minus the
+  // truncation our buffer may have seen.
+  msg->msg_flags = shadow.msg_flags & ~MSG_CTRUNC;
+  return n;
+}
+
+ssize_t send(int fd, const void* buf, size_t len, int flags) {
+  ssize_t n = real_send(fd, buf, len, flags);
+  RecordWire(Stage::kWireSend, fd, n, buf);
+  return n;
+}
+
+ssize_t recv(int fd, void* buf, size_t len, int flags) {
+  ssize_t n = real_recv(fd, buf, len, flags);
+  RecordWire(Stage::kWireRecv, fd, n, buf);
+  return n;
+}
+
+ssize_t sendto(int fd, const void* buf, size_t len, int flags,
+               const struct sockaddr* addr, socklen_t addrlen) {
+  ssize_t n = real_sendto(fd, buf, len, flags, addr, addrlen);
+  RecordWire(Stage::kWireSend, fd, n, buf);
+  return n;
+}
+
+ssize_t recvfrom(int fd, void* buf, size_t len, int flags,
+                 struct sockaddr* addr, socklen_t* addrlen) {
+  ssize_t n = real_recvfrom(fd, buf, len, flags, addr, addrlen);
+  RecordWire(Stage::kWireRecv, fd, n, buf);
+  return n;
+}
+
+int close(int fd) {
+  if (fd >= 0 && fd < kMaxFd) {
+    g_fd_is_socket[fd].store(-1, std::memory_order_relaxed);
+  }
+  return real_close(fd);
+}
+
+// Freeze-and-flush hook for the probe's outlier trigger. Probes declare
+// this weak (see submit_order's --freeze-outlier-ms) so the call binds
+// only when the interposer is actually preloaded.
+void sockwatch_capture_freeze() { g_capture.Freeze(); }
+
+}  // extern "C"
@@ -0,0 +1,149 @@
+/**
+ * Per-stage timing instrumentation for the Concords stock client.
+ *
+ * Probes are parameterized on a timing policy so a build that does not want
+ * instrumentation pays nothing: with TimingDisabled every Now()/Record() call
+ * is an empty inline function and StageScope is an empty object, so the
+ * probes compile away entirely (no runtime enable_timing branches left on
+ * the hot path).
+ *
+ * Build with -DLATENCYLAB_DISABLE_TIMING to select the null policy.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#include "stock-client/order.h"
+#include "stock-client/stock_client.h"
+
+#include "stages.h"
+#include "tsc_clock.h"
+
+namespace latencylab {
+
+// Active policy: one ProbeClock read per mark (calibrated TSC where the
+// hardware has it), records forwarded to a sink. The default sink keeps the
+// existing stderr marker format so current log scraping keeps working.
+struct ActiveTiming {
+  static constexpr bool kEnabled = true;
+
+  using Sink = void (*)(Stage stage, uint64_t begin_ns, uint64_t end_ns);
+
+  static uint64_t Now() { return ProbeClock::NowNs(); }
+
+  static void Record(Stage stage, uint64_t begin_ns, uint64_t end_ns) {
+    sink()(stage, begin_ns, end_ns);
+  }
+
+  static void SetSink(Sink sink_fn) { sink() = sink_fn; }
+
+  // The default sink; public so a probe that swapped sinks temporarily
+  // (e.g. during warmup) can restore it.
+  static void StderrSink(Stage stage, uint64_t begin_ns, uint64_t end_ns) {
+    std::cerr << "===STAGE=" << StageName(stage) << "=" << begin_ns << "="
+              << (end_ns - begin_ns) << "===" << std::endl;
+  }
+
+ private:
+ static Sink& sink() {
+    static Sink sink_fn = &StderrSink;
+    return sink_fn;
+  }
+};
+
+// Null policy: everything inlines to nothing.
+struct TimingDisabled {
+  static constexpr bool kEnabled = false;
+
+  using Sink = void (*)(Stage stage, uint64_t begin_ns, uint64_t end_ns);
+
+  static uint64_t Now() { return 0; }
+  static void Record(Stage, uint64_t, uint64_t) {}
+  static void SetSink(Sink) {}
+};
+
+#ifdef LATENCYLAB_DISABLE_TIMING
+using ProbeTiming = TimingDisabled;
+#else
+using ProbeTiming = ActiveTiming;
+#endif
+
+// RAII bracket for one stage. With TimingDisabled this is an empty object
+// whose constructor and destructor compile away.
+template <typename Policy>
+class StageScope {
+ public:
+  explicit StageScope(Stage stage) : stage_(stage), begin_ns_(Policy::Now()) {}
+
+  ~StageScope() { Policy::Record(stage_, begin_ns_, Policy::Now()); }
+
+  StageScope(const StageScope&) = delete;
+  StageScope& operator=(const StageScope&) = delete;
+
+ private:
+  Stage stage_;
+  uint64_t begin_ns_;
+};
+
+// Point event: begin == end.
+template <typename Policy>
+inline void MarkStage(Stage stage) {
+  uint64_t now = Policy::Now();
+  Policy::Record(stage, now, now);
+}
+
+// Wraps a StockClient and stamps lifecycle stages as calls and callbacks
+// cross the wrapper boundary. Forwarded methods keep the SDK signatures so
+// the harness swaps in transparently.
+template <typename Policy>
+class InstrumentedStockClient {
+ public:
+  using SubmitCallback =
+      std::function<void(const concordsapi::stockclient::OrderSubmitResult&)>;
+  using CancelCallback =
+      std::function<void(const concordsapi::stockclient::OrderCancelResult&)>;
+
+  explicit InstrumentedStockClient(
+      std::unique_ptr<concordsapi::stockclient::StockClient> client)
+      : client_(std::move(client)) {}
+
+  bool Connect() { return client_->Connect(); }
+  bool Login() { return client_->Login(); }
+  bool IsConnected() { return client_->IsConnected(); }
+  void Disconnect() { client_->Disconnect(); }
+
+  void SubmitOrder(const concordsapi::stockclient::OrderInfo& order_info) {
+    StageScope<Policy> scope(Stage::kSubmitCall);
+    client_->SubmitOrder(order_info);
+  }
+
+  void CancelOrder(const std::string& order_id,
+                   const std::string& order_ticket_id,
+                   const concordsapi::stockclient::OrderInfo& order_info) {
+    StageScope<Policy> scope(Stage::kCancelCall);
+    client_->CancelOrder(order_id, order_ticket_id, order_info);
+  }
+
+  void SetOrderSubmitCallback(SubmitCallback callback) {
+    client_->SetOrderSubmitCallback(
+        [callback = std::move(callback)](
+            const concordsapi::stockclient::OrderSubmitResult& result) {
+          MarkStage<Policy>(Stage::kCallbackEntry);
+          callback(result);
+        });
+  }
+
+  void SetOrderCancelCallback(CancelCallback callback) {
+    client_->SetOrderCancelCallback(std::move(callback));
+  }
+
+ private:
+  std::unique_ptr<concordsapi::stockclient::StockClient> client_;
+};
+
+}  // namespace latencylab
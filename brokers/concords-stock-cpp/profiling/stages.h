@@ -0,0 +1,116 @@
+/**
+ * Stage ids shared between the instrumentation layer, the binary log and
+ * offline tooling. Kept free of SDK includes so readers/analyzers build
+ * without the stock-client tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace latencylab {
+
+// Named points in the order lifecycle. kOrderBuild/kSubmitCall/kCancelCall
+// are bracketed by the harness; kSerialize/kSocketWrite/kAckParse are
+// reserved for an SDK built with stage hooks; kCallbackEntry is a point
+// event stamped when the SDK dispatches into our callback. kSubmitTotal is
+// the legacy START-to-callback window (what TOTAL_NS used to report).
+enum class Stage : uint8_t {
+  kOrderBuild = 0,
+  kSerialize,
+  kSocketWrite,
+  kAckParse,
+  kCallbackEntry,
+  kSubmitCall,
+  kCancelCall,
+  kSubmitTotal,
+  kCancelTotal,
+  // Wire events captured by the sockwatch interposer. These are point
+  // events: duration_ns carries the byte count and flags carries the fd.
+  kWireSend,
+  kWireRecv,
+  // Kernel/NIC RX timestamps (SO_TIMESTAMPING): timestamp_ns is when the
+  // packet hit the stack/NIC, duration_ns is the lag until our recvmsg
+  // observed it, flags carries the fd.
+  kWireRecvKernel,
+  kWireRecvHw,
+  // Background TCP-ping sample (rtt_prober.h): duration_ns is the connect
+  // RTT, flags is the target index. The submit records emitted while a
+  // prober runs carry its latest estimate (µs, clamped) in their flags.
+  kRttProbe,
+  // Scheduler contamination marker (--realtime, realtime.h): a sample whose
+  // thread took involuntary context switches. duration_ns is the nivcsw
+  // delta; flags is 0 for the submit thread, 1 for the SDK callback thread.
+  kCtxSwitch,
+  // Regime boundary from the online detector (regime_detector.h):
+  // duration_ns is the new window's p50, flags bit0/bit1 say whether p50/
+  // p99 crossed the configured band.
+  kRegimeShift,
+  // Clock sync against broker server timestamps (clock_sync.h).
+  // kClockOffset: duration_ns is |offset|, flags bit0 set when the
+  // broker's clock reads ahead of ours. kOneWayOut/kOneWayBack: estimated
+  // outbound/inbound halves of one exchange, timestamped at its start.
+  kClockOffset,
+  kOneWayOut,
+  kOneWayBack,
+  // Session outage bridged by the keep-alive layer (session_keeper.h):
+  // timestamp_ns is when the monitor saw the drop, duration_ns the outage
+  // length, flags the reconnect attempts it took (clamped).
+  kSessionOutage,
+  // SLO breach from --budget (budget.h): duration_ns is the measured
+  // value, flags the stage id whose budget it broke, timestamp the
+  // sample's start so it joins against the offending record.
+  kBudgetBreach,
+  kStageCount,
+};
+
+inline const char* StageName(Stage stage) {
+  switch (stage) {
+    case Stage::kOrderBuild:
+      return "order_build";
+    case Stage::kSerialize:
+      return "serialize";
+    case Stage::kSocketWrite:
+      return "socket_write";
+    case Stage::kAckParse:
+      return "ack_parse";
+    case Stage::kCallbackEntry:
+      return "callback_entry";
+    case Stage::kSubmitCall:
+      return "submit_call";
+    case Stage::kCancelCall:
+      return "cancel_call";
+    case Stage::kSubmitTotal:
+      return "submit_total";
+    case Stage::kCancelTotal:
+      return "cancel_total";
+    case Stage::kWireSend:
+      return "wire_send";
+    case Stage::kWireRecv:
+      return "wire_recv";
+    case Stage::kWireRecvKernel:
+      return "wire_recv_kernel";
+    case Stage::kWireRecvHw:
+      return "wire_recv_hw";
+    case Stage::kRttProbe:
+      return "rtt_probe";
+    case Stage::kCtxSwitch:
+      return "ctx_switch";
+    case Stage::kRegimeShift:
+      return "regime_shift";
+    case Stage::kClockOffset:
+      return "clock_offset";
+    case Stage::kOneWayOut:
+      return "one_way_out";
+    case Stage::kOneWayBack:
+      return "one_way_back";
+    case Stage::kSessionOutage:
+      return "session_outage";
+    case Stage::kBudgetBreach:
+      return "budget_breach";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace latencylab
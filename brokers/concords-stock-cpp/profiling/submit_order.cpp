@@ -5,77 +5,335 @@
  *     ./submit_order                              # Uses order_config.toml
  *     ./submit_order --no-timing                  # Disable timing markers
  *     ./submit_order --config order_config.toml   # Use custom config file
+ *     ./submit_order --daemon --interval 30       # Loop submit/cancel cycles
+ *                                                 # on one warm session
+ *     ./submit_order --log latency.bin            # Binary mmap log instead
+ *                                                 # of stderr markers
+ *     ./submit_order --spin [--spin-core N]       # Busy-poll completions
+ *                                                 # instead of condvar waits
+ *     ./submit_order --burst 50 --window 10       # Pipeline 50 in-flight
+ *                                                 # orders, repeat 10 times
+ *     ./submit_order --cancel-delay-ms 0          # Cancel immediately after
+ *                                                 # the ACK (default 1000)
+ *     ./submit_order --warmup 3                   # 3 untimed submit/cancel
+ *                                                 # exchanges before arming
+ *                                                 # the timing markers
+ *     ./submit_order --realtime [--rt-core N]     # SCHED_FIFO + pinning for
+ *                    [--rt-callback-core N]       # the submit and callback
+ *                                                 # threads; contaminated
+ *                                                 # samples get kCtxSwitch
+ *                                                 # records
+ *     ./submit_order --compile-config cfg.bin     # Validate the TOML and
+ *                                                 # emit a binary snapshot;
+ *                                                 # --config cfg.bin then
+ *                                                 # starts without parsing
+ *     ./submit_order --budget                     # Assert the [budget]
+ *                                                 # per-stage SLOs on every
+ *                                                 # sample; breaches emit
+ *                                                 # kBudgetBreach records
+ *     ./submit_order --freeze-outlier-ms 50       # Flush the sockwatch
+ *                                                 # capture ring when a
+ *                                                 # submit exceeds 50ms
+ *                                                 # (needs the preloaded
+ *                                                 # interposer with
+ *                                                 # SOCKWATCH_CAPTURE set)
+ *
+ * Per-stage probes (see stage_timer.h) are compiled out entirely when built
+ * with -DLATENCYLAB_DISABLE_TIMING; --no-timing only silences the legacy
+ * START/END/TOTAL_NS markers.
+ *
+ * A [matrix] config section (lists of values for the [order] enum fields,
+ * see order_config.h) makes the daemon round-robin the cross product of
+ * variants within the one warm session; each submit record's flags carry
+ * the variant id and per-variant percentiles print at exit.
+ *
+ * An [rtt] config section (see rtt_prober.h) starts a background prober
+ * whose samples land in the log as kRttProbe records; submit records then
+ * carry the contemporaneous RTT estimate (µs) in their flags.
+ *
+ * A [budget] config section (per-stage SLOs in milliseconds, see
+ * budget.h) with --budget turns the probe into a live monitor: every
+ * stage sample is checked as it is stamped, and a breach emits a
+ * kBudgetBreach record naming the violated stage.
+ *
+ * A snapshot passed to --config (see config_snapshot.h) carries [user]
+ * and the base [order] only; the optional [matrix]/[rtt]/[report]/[regime]
+ * sections need the TOML.
  */
 
 #include <toml++/toml.h>
 
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
+#include <csignal>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <iostream>
 #include <memory>
-#include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include "stock-client/order.h"
 #include "stock-client/stock_client.h"
 
+#include "arena.h"
+#include "binary_log.h"
+#include "budget.h"
+#include "cancel_scheduler.h"
+#include "clock_sync.h"
+#include "completion.h"
+#include "config_snapshot.h"
+#include "histogram.h"
+#include "log_ring.h"
+#include "order_config.h"
+#include "order_template.h"
+#include "realtime.h"
+#include "regime_detector.h"
+#include "rtt_prober.h"
+#include "session_keeper.h"
+#include "stage_timer.h"
+#include "udp_reporter.h"
+
 using namespace concordsapi::stockclient;
 
-Market parseMarket(const std::string& str) {
-  if (str == "TSE") return Market::TSE;
-  if (str == "OTC") return Market::OTC;
-  std::cerr << "Invalid market: " << str << std::endl;
-  exit(1);
+using latencylab::BinaryLog;
+using latencylab::BudgetChecker;
+using latencylab::CancelScheduler;
+using latencylab::ClockSync;
+using latencylab::Completion;
+using latencylab::CtxSwitchWatch;
+using latencylab::CycleArena;
+using latencylab::InstrumentedStockClient;
+using latencylab::LatencyHistogram;
+using latencylab::LogRingWriter;
+using latencylab::ProbeClock;
+using latencylab::ProbeTiming;
+using latencylab::RegimeDetector;
+using latencylab::RttProber;
+using latencylab::SessionKeeper;
+using latencylab::Stage;
+using latencylab::StageScope;
+using latencylab::UdpReporter;
+
+// Capture-ring freeze hook exported by libsockwatch (sockwatch.cpp).
+// Weak so the probe runs unchanged without the preload; non-null only
+// when the interposer is loaded.
+extern "C" void sockwatch_capture_freeze() __attribute__((weak));
+
+// Samples go here when --log is given. Measurement threads never touch
+// the mapped file themselves: every record goes through a per-thread SPSC
+// ring and the writer thread behind g_log_writer is the only appender, so
+// a sample costs the producer one slot copy and one release store.
+BinaryLog g_latency_log;
+LogRingWriter g_log_writer(g_latency_log);
+
+// Live SLO assertions; idle unless --budget arms the [budget] section.
+BudgetChecker g_budget;
+
+void logSink(Stage stage, uint64_t begin_ns, uint64_t end_ns) {
+  g_budget.Observe(stage, begin_ns, end_ns - begin_ns);
+  g_log_writer.Append(stage, begin_ns, end_ns - begin_ns);
 }
 
-OrderBoard parseOrderBoard(const std::string& str) {
-  if (str == "RoundLot") return OrderBoard::RoundLot;
-  if (str == "OddLot") return OrderBoard::OddLot;
-  if (str == "PostMarket_Fixed") return OrderBoard::PostMarket_Fixed;
-  if (str == "PostMarket_OddLot") return OrderBoard::PostMarket_OddLot;
-  std::cerr << "Invalid order_board: " << str << std::endl;
-  exit(1);
+// --budget without --log: budget-check the stage marks on their way to
+// the usual stderr sink.
+void budgetStderrSink(Stage stage, uint64_t begin_ns, uint64_t end_ns) {
+  g_budget.Observe(stage, begin_ns, end_ns - begin_ns);
+  latencylab::ActiveTiming::StderrSink(stage, begin_ns, end_ns);
 }
 
-FundingType parseFundingType(const std::string& str) {
-  if (str == "Cash") return FundingType::Cash;
-  if (str == "MarginBuy") return FundingType::MarginBuy;
-  if (str == "MarginShortSell") return FundingType::MarginShortSell;
-  std::cerr << "Invalid funding_type: " << str << std::endl;
-  exit(1);
-}
+// Stage sink during --warmup: exchanges run, nothing is recorded.
+void quietSink(Stage, uint64_t, uint64_t) {}
+
+// Set by SIGINT/SIGTERM so the daemon loop can finish its in-flight cycle
+// and disconnect cleanly instead of dying mid-order.
+std::atomic<bool> g_stop_requested{false};
+
+void handleStopSignal(int) { g_stop_requested = true; }
+
+// SIGUSR1 asks the daemon loop for a percentile snapshot between cycles.
+std::atomic<bool> g_stats_requested{false};
+
+void handleStatsSignal(int) { g_stats_requested = true; }
+
+// Every TOTAL_NS sample is also fed here; Record() is O(1) lock-free so it
+// is safe inside the submit callback.
+LatencyHistogram g_submit_histogram;
+
+// Cancel round-trip (CancelOrder call to cancel callback), measured now
+// that cancels are issued from the scheduler instead of a sleeping SDK
+// callback thread.
+LatencyHistogram g_cancel_histogram;
+
+// Network weather: idle unless the config has an [rtt] section. While it
+// runs, its latest estimate rides in the flags of each submit record.
+RttProber g_rtt_prober;
+
+// Fire-and-forget reports to the central collector; idle unless the
+// config has a [report] section.
+UdpReporter g_reporter;
+
+// Online regime detection over submit totals; idle unless the config has
+// a [regime] section.
+RegimeDetector g_regime_detector;
+
+// Offset to the broker clock, fed from order exchanges when the SDK
+// build surfaces the server timestamp (see clock_sync.h).
+ClockSync g_clock_sync;
+
+// Per-cycle order state (ids copied out of result structs) lives here and
+// is released with a pointer bump between cycles. 64K is orders of
+// magnitude more than one lifecycle needs.
+CycleArena g_cycle_arena(64 * 1024);
+
+// --- Burst mode -----------------------------------------------------------
+//
+// Pipelines N submissions without waiting so queueing onset at the
+// Endpoint/Frontend hops becomes visible. Slots are preallocated; the ACK
+// callback claims the next slot in arrival order and copies the ids into
+// fixed buffers (no allocation on the callback thread). Correlation relies
+// on the single HTTP/2 connection delivering ACKs in submission order; the
+// per-position report makes any reordering obvious as a negative latency.
+
+constexpr int kMaxBurst = 256;
+
+struct BurstSlot {
+  uint64_t submit_ns = 0;
+  uint64_t ack_ns = 0;
+  char order_id[32] = {};
+  char order_ticket_id[32] = {};
+  bool acked = false;
+};
+
+BurstSlot g_burst_slots[kMaxBurst];
+std::atomic<int> g_burst_acks{0};
+
+int runBurst(InstrumentedStockClient<ProbeTiming>& client,
+             const OrderInfo& order_info, int burst_n, int windows,
+             int interval_seconds, bool spin_wait) {
+  Completion acks_done(spin_wait);
+  Completion cancels_done(spin_wait);
+
+  client.SetOrderSubmitCallback([&](const OrderSubmitResult& result) {
+    int slot_idx = g_burst_acks.fetch_add(1, std::memory_order_relaxed);
+    if (slot_idx < kMaxBurst) {
+      BurstSlot& slot = g_burst_slots[slot_idx];
+      slot.ack_ns = ProbeClock::NowNs();
+      slot.acked = result.success;
+      if (result.success) {
+        strncpy(slot.order_id, result.order_id.c_str(),
+                sizeof(slot.order_id) - 1);
+        strncpy(slot.order_ticket_id, result.order_ticket_id.c_str(),
+                sizeof(slot.order_ticket_id) - 1);
+      }
+    }
+    acks_done.Signal();
+  });
 
-Side parseSide(const std::string& str) {
-  if (str == "Buy" || str == "B") return Side::Buy;
-  if (str == "Sell" || str == "S") return Side::Sell;
-  std::cerr << "Invalid side: " << str << std::endl;
-  exit(1);
-}
+  client.SetOrderCancelCallback(
+      [&](const OrderCancelResult&) { cancels_done.Signal(); });
 
-OrderType parseOrderType(const std::string& str) {
-  if (str == "Limit") return OrderType::Limit;
-  if (str == "Market") return OrderType::Market;
-  std::cerr << "Invalid order_type: " << str << std::endl;
-  exit(1);
-}
+  if (!client.Connect()) {
+    std::cerr << "Failed to connect" << std::endl;
+    return 1;
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  if (!client.Login()) {
+    std::cerr << "Failed to login" << std::endl;
+    return 1;
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  std::cerr << "Connected and logged in" << std::endl;
 
-TimeInForce parseTimeInForce(const std::string& str) {
-  if (str == "ROD") return TimeInForce::ROD;
-  if (str == "IOC") return TimeInForce::IOC;
-  if (str == "FOK") return TimeInForce::FOK;
-  std::cerr << "Invalid time_in_force: " << str << std::endl;
-  exit(1);
-}
+  // Mean per-position latency aggregated across windows.
+  uint64_t position_total_ns[kMaxBurst] = {};
+  uint64_t position_samples[kMaxBurst] = {};
+
+  for (int window = 0; window < windows && !g_stop_requested; window++) {
+    for (int i = 0; i < burst_n; i++) {
+      g_burst_slots[i] = BurstSlot{};
+    }
+    g_burst_acks.store(0, std::memory_order_relaxed);
+
+    std::cerr << "--- Burst window " << (window + 1) << "/" << windows
+              << ": " << burst_n << " in flight ---" << std::endl;
+
+    for (int i = 0; i < burst_n; i++) {
+      g_burst_slots[i].submit_ns = ProbeClock::NowNs();
+      client.SubmitOrder(order_info);
+    }
+
+    bool complete = true;
+    for (int i = 0; i < burst_n; i++) {
+      if (!acks_done.WaitNext(std::chrono::seconds(10))) {
+        std::cerr << "Timeout: " << g_burst_acks.load() << "/" << burst_n
+                  << " ACKs received" << std::endl;
+        complete = false;
+        break;
+      }
+    }
+
+    int acked = std::min(g_burst_acks.load(), burst_n);
+    for (int i = 0; i < acked; i++) {
+      const BurstSlot& slot = g_burst_slots[i];
+      if (!slot.acked) continue;
+      int64_t latency_ns =
+          static_cast<int64_t>(slot.ack_ns) -
+          static_cast<int64_t>(g_burst_slots[i].submit_ns);
+      std::cerr << "position=" << i << " latency_ns=" << latency_ns
+                << std::endl;
+      if (latency_ns > 0) {
+        g_submit_histogram.Record(static_cast<uint64_t>(latency_ns));
+        if (g_latency_log.IsOpen()) {
+          g_log_writer.Append(Stage::kSubmitTotal, slot.submit_ns,
+                               static_cast<uint64_t>(latency_ns),
+                               static_cast<uint16_t>(i));
+        }
+        position_total_ns[i] += static_cast<uint64_t>(latency_ns);
+        position_samples[i]++;
+      }
+    }
+
+    // Tear down everything that got a ticket before the next window.
+    int cancels_sent = 0;
+    for (int i = 0; i < acked; i++) {
+      const BurstSlot& slot = g_burst_slots[i];
+      if (!slot.acked) continue;
+      client.CancelOrder(slot.order_id, slot.order_ticket_id, order_info);
+      cancels_sent++;
+    }
+    for (int i = 0; i < cancels_sent; i++) {
+      if (!cancels_done.WaitNext(std::chrono::seconds(10))) {
+        std::cerr << "Timeout waiting for cancels" << std::endl;
+        break;
+      }
+    }
+
+    if (!complete && !g_stop_requested) {
+      std::cerr << "Window incomplete, continuing" << std::endl;
+    }
+    if (window + 1 < windows) {
+      std::this_thread::sleep_for(std::chrono::seconds(interval_seconds));
+    }
+  }
+
+  std::cerr << "Per-position mean latency across windows:" << std::endl;
+  for (int i = 0; i < burst_n; i++) {
+    if (position_samples[i] == 0) continue;
+    std::cerr << "  position=" << i << " mean_ns="
+              << (position_total_ns[i] / position_samples[i])
+              << " samples=" << position_samples[i] << std::endl;
+  }
+  g_submit_histogram.Print(std::cerr, "burst_submit");
 
-DaytradeShortSell parseDaytradeShortSell(const std::string& str) {
-  if (str == "True" || str == "Y") return DaytradeShortSell::True;
-  if (str == "False" || str == "N") return DaytradeShortSell::False;
-  std::cerr << "Invalid daytrade_shortsell: " << str << std::endl;
-  exit(1);
+  if (client.IsConnected()) {
+    client.Disconnect();
+  }
+  return 0;
 }
 
 std::string find_config_file(const char* arg_config) {
@@ -88,152 +346,540 @@ std::string find_config_file(const char* arg_config) {
 
 int main(int argc, char* argv[]) {
   bool enable_timing = true;
+  bool daemon_mode = false;
+  bool spin_wait = false;
+  int spin_core = -1;
+  int interval_seconds = 10;
+  int burst_n = 0;
+  int burst_windows = 1;
+  int cancel_delay_ms = 1000;
+  int warmup_cycles = 0;
+  bool realtime_mode = false;
+  int rt_core = -1;
+  int rt_callback_core = -1;
   const char* config_path = nullptr;
+  const char* log_path = nullptr;
+  const char* compile_out = nullptr;
+  uint64_t freeze_outlier_ns = 0;
+  bool budget_mode = false;
 
   for (int i = 1; i < argc; i++) {
     if (strcmp(argv[i], "--no-timing") == 0) {
       enable_timing = false;
+    } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+      log_path = argv[i + 1];
+      i++;
+    } else if (strcmp(argv[i], "--daemon") == 0) {
+      daemon_mode = true;
+    } else if (strcmp(argv[i], "--cancel-delay-ms") == 0 && i + 1 < argc) {
+      cancel_delay_ms = atoi(argv[i + 1]);
+      if (cancel_delay_ms < 0) {
+        std::cerr << "Invalid cancel delay: " << argv[i + 1] << std::endl;
+        return 1;
+      }
+      i++;
+    } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+      warmup_cycles = atoi(argv[i + 1]);
+      if (warmup_cycles < 0) {
+        std::cerr << "Invalid warmup count: " << argv[i + 1] << std::endl;
+        return 1;
+      }
+      i++;
+    } else if (strcmp(argv[i], "--burst") == 0 && i + 1 < argc) {
+      burst_n = atoi(argv[i + 1]);
+      if (burst_n <= 0 || burst_n > kMaxBurst) {
+        std::cerr << "Invalid burst size (1.." << kMaxBurst
+                  << "): " << argv[i + 1] << std::endl;
+        return 1;
+      }
+      i++;
+    } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+      burst_windows = atoi(argv[i + 1]);
+      if (burst_windows <= 0) {
+        std::cerr << "Invalid window count: " << argv[i + 1] << std::endl;
+        return 1;
+      }
+      i++;
+    } else if (strcmp(argv[i], "--realtime") == 0) {
+      realtime_mode = true;
+    } else if (strcmp(argv[i], "--rt-core") == 0 && i + 1 < argc) {
+      rt_core = atoi(argv[i + 1]);
+      i++;
+    } else if (strcmp(argv[i], "--rt-callback-core") == 0 && i + 1 < argc) {
+      rt_callback_core = atoi(argv[i + 1]);
+      i++;
+    } else if (strcmp(argv[i], "--spin") == 0) {
+      spin_wait = true;
+    } else if (strcmp(argv[i], "--spin-core") == 0 && i + 1 < argc) {
+      spin_core = atoi(argv[i + 1]);
+      i++;
+    } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+      interval_seconds = atoi(argv[i + 1]);
+      if (interval_seconds <= 0) {
+        std::cerr << "Invalid interval: " << argv[i + 1] << std::endl;
+        return 1;
+      }
+      i++;
     } else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
       config_path = argv[i + 1];
       i++;
+    } else if (strcmp(argv[i], "--compile-config") == 0 && i + 1 < argc) {
+      compile_out = argv[i + 1];
+      i++;
+    } else if (strcmp(argv[i], "--budget") == 0) {
+      budget_mode = true;
+    } else if (strcmp(argv[i], "--freeze-outlier-ms") == 0 && i + 1 < argc) {
+      int ms = atoi(argv[i + 1]);
+      if (ms <= 0) {
+        std::cerr << "Invalid outlier threshold: " << argv[i + 1] << std::endl;
+        return 1;
+      }
+      freeze_outlier_ns = static_cast<uint64_t>(ms) * 1'000'000ull;
+      if (!sockwatch_capture_freeze) {
+        std::cerr << "--freeze-outlier-ms has no effect without the "
+                     "preloaded sockwatch interposer" << std::endl;
+      }
+      i++;
     }
   }
 
+  // Calibrate before the first sample; ~10ms, falls back to chrono on
+  // hardware without invariant TSC.
+  ProbeClock::Calibrate();
+  latencylab::LockAllMemory();
+  if (!ProbeClock::UsingTsc()) {
+    std::cerr << "Invariant TSC unavailable, timestamps use chrono"
+              << std::endl;
+  }
+
+  // The config is either the TOML or a precompiled snapshot of its hot
+  // core ([user] + base [order]); the snapshot skips toml++ entirely,
+  // which is most of our non-network startup when the fleet relaunches
+  // at market open. A snapshot leaves `config` as an empty table, so the
+  // optional-section lookups below simply find nothing.
   std::string config_file = find_config_file(config_path);
-  auto config = toml::parse_file(config_file);
-
-  std::string user_id = *config["user"]["user_id"].value<std::string>();
-  std::string password = *config["user"]["password"].value<std::string>();
-  std::string account = *config["user"]["account"].value<std::string>();
-  std::string pfx_filepath =
-      *config["user"]["pfx_filepath"].value<std::string>();
-  std::string pfx_password =
-      *config["user"]["pfx_password"].value<std::string>();
-
-  auto client =
-      BuildStockClient(user_id.c_str(), password.c_str(), account.c_str(),
-                       pfx_filepath.c_str(), pfx_password.c_str());
-
-  std::string symbol = *config["order"]["symbol"].value<std::string>();
-  std::string price = *config["order"]["price"].value<std::string>();
-  std::string quantity = *config["order"]["quantity"].value<std::string>();
-  Market market = parseMarket(*config["order"]["market"].value<std::string>());
-  OrderBoard order_board =
-      parseOrderBoard(*config["order"]["order_board"].value<std::string>());
-  FundingType funding_type =
-      parseFundingType(*config["order"]["funding_type"].value<std::string>());
-  Side side = parseSide(*config["order"]["side"].value<std::string>());
-  OrderType order_type =
-      parseOrderType(*config["order"]["order_type"].value<std::string>());
-  TimeInForce time_in_force =
-      parseTimeInForce(*config["order"]["time_in_force"].value<std::string>());
-  DaytradeShortSell daytrade_shortsell = parseDaytradeShortSell(
-      *config["order"]["daytrade_shortsell"].value<std::string>());
-
-  OrderInfo order_info(market, order_board, funding_type, symbol, side,
-                       order_type, time_in_force, quantity, price,
-                       daytrade_shortsell);
-
-  std::atomic<bool> order_submitted{false};
-  std::atomic<bool> order_cancelled{false};
-  std::string current_order_id;
-  std::string current_order_ticket_id;
-  std::mutex mtx;
-  std::condition_variable cv, cancel_cv;
+  const bool from_snapshot = latencylab::IsSnapshotFile(config_file.c_str());
+  latencylab::ConfigSnapshot snapshot;
+  toml::table config;
+  if (from_snapshot) {
+    if (compile_out) {
+      std::cerr << "--compile-config needs the TOML, not a snapshot"
+                << std::endl;
+      return 1;
+    }
+    if (!latencylab::ReadSnapshot(config_file.c_str(), snapshot)) {
+      return 1;
+    }
+  } else {
+    config = toml::parse_file(config_file);
+  }
+
+  if (compile_out) {
+    return latencylab::CompileConfig(config, compile_out) ? 0 : 1;
+  }
+
+  if (log_path) {
+    // 1M records (~24MB) is hours of daemon-mode samples.
+    if (!g_latency_log.Open(log_path, latencylab::kBrokerIdConcords,
+                            1 << 20)) {
+      return 1;
+    }
+    g_log_writer.Start();
+    ProbeTiming::SetSink(&logSink);
+  }
+
+  if (budget_mode) {
+    if (!g_budget.Configure(config)) {
+      std::cerr << "--budget needs a [budget] config section (TOML only)"
+                << std::endl;
+      return 1;
+    }
+    g_budget.Arm(g_latency_log.IsOpen() ? &g_log_writer : nullptr);
+    if (!g_latency_log.IsOpen()) {
+      ProbeTiming::SetSink(&budgetStderrSink);
+    }
+  }
+
+  if (config["regime"]["window"]) {
+    g_regime_detector.Configure(config["regime"]["window"].value_or(64),
+                                config["regime"]["band_pct"].value_or(50.0));
+  }
+
+  if (auto collector = config["report"]["collector"].value<std::string>()) {
+    if (!g_reporter.Open(*collector, latencylab::kBrokerIdConcords)) {
+      return 1;
+    }
+  }
+
+  if (const toml::array* targets = config["rtt"]["targets"].as_array()) {
+    for (const toml::node& node : *targets) {
+      if (auto spec = node.value<std::string>()) {
+        if (!g_rtt_prober.AddTarget(*spec)) {
+          return 1;
+        }
+      }
+    }
+    if (g_rtt_prober.TargetCount() > 0 &&
+        !g_rtt_prober.Start(&g_log_writer,
+                            config["rtt"]["interval_ms"].value_or(500))) {
+      return 1;
+    }
+  }
+
+  latencylab::ClientCredentials creds =
+      from_snapshot ? latencylab::CredentialsFromSnapshot(snapshot)
+                    : latencylab::LoadCredentials(config["user"]);
+
+  auto client = std::make_unique<InstrumentedStockClient<ProbeTiming>>(
+      BuildStockClient(creds.user_id.c_str(), creds.password.c_str(),
+                       creds.account.c_str(), creds.pfx_filepath.c_str(),
+                       creds.pfx_password.c_str()));
+
+  // Built once; every cycle submits an immutable template so the timed
+  // window never includes our own order construction. A [matrix] config
+  // section expands to several templates (A/B sweep); otherwise this is
+  // the single base order.
+  uint64_t build_begin_ns = ProbeTiming::Now();
+  std::vector<latencylab::OrderVariant> variants;
+  if (from_snapshot) {
+    variants.push_back({"base", latencylab::OrderFromSnapshot(snapshot)});
+  } else {
+    variants = latencylab::BuildOrderMatrix(config);
+  }
+  ProbeTiming::Record(Stage::kOrderBuild, build_begin_ns, ProbeTiming::Now());
+  const OrderInfo& order_info = variants[0].prepared.order();
+  const bool matrix_mode = variants.size() > 1;
+
+  std::vector<std::unique_ptr<LatencyHistogram>> variant_histograms;
+  if (matrix_mode) {
+    std::cerr << "Matrix mode: " << variants.size() << " variants"
+              << std::endl;
+    for (const auto& variant : variants) {
+      std::cerr << "  " << variant.label << std::endl;
+      variant_histograms.push_back(std::make_unique<LatencyHistogram>());
+    }
+  }
+
+  if (burst_n > 0) {
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+    if (spin_core >= 0) {
+      latencylab::PinThisThread(spin_core);
+    }
+    return runBurst(*client, order_info, burst_n, burst_windows,
+                    interval_seconds, spin_wait);
+  }
+
+  // True while --warmup exchanges run; callbacks then skip every histogram,
+  // log and marker write so warmup never pollutes the distribution.
+  bool warming = false;
+
+  // --realtime: one watch per measurement thread. The callback watch lives
+  // here but is only ever touched from the SDK callback thread.
+  CtxSwitchWatch submit_ctx;
+  CtxSwitchWatch callback_ctx;
+  bool callback_rt_armed = false;
+
+  // Which template the in-flight cycle used; round-robined by the daemon
+  // loop in matrix mode, fixed at the base order otherwise.
+  size_t variant_idx = 0;
+  const OrderInfo* cycle_order = &order_info;
+
+  std::string_view current_order_id;
+  std::string_view current_order_ticket_id;
+  Completion submit_done(spin_wait);
+  Completion cancel_done(spin_wait);
+  CancelScheduler cancel_scheduler;
   uint64_t submit_end_ns = 0;
   uint64_t start_ns = 0;
+  uint64_t cancel_start_ns = 0;
 
   client->SetOrderSubmitCallback([&](const OrderSubmitResult& result) {
-    if (enable_timing) {
-      auto end = std::chrono::high_resolution_clock::now();
-      submit_end_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                          end.time_since_epoch())
-                          .count();
+    // First dispatch on the SDK callback thread: elevate it too. The SDK
+    // owns the thread, so this is the only place we can reach it.
+    if (realtime_mode && !callback_rt_armed) {
+      callback_rt_armed = true;
+      latencylab::EnableRealtime(rt_callback_core);
+      callback_ctx.Begin();
+    }
 
-      std::cerr << "===END=" << submit_end_ns << "===" << std::endl;
-      std::cerr << "TOTAL_NS=" << (submit_end_ns - start_ns) << std::endl;
+    if (enable_timing && !warming) {
+      submit_end_ns = ProbeClock::NowNs();
+
+      g_submit_histogram.Record(submit_end_ns - start_ns);
+      g_budget.Observe(Stage::kSubmitTotal, start_ns,
+                       submit_end_ns - start_ns);
+      if (matrix_mode) {
+        variant_histograms[variant_idx]->Record(submit_end_ns - start_ns);
+      }
+
+      if (g_latency_log.IsOpen()) {
+        // Matrix mode claims the flags for the variant id; the RTT weather
+        // series is still in the kRttProbe records either way.
+        g_log_writer.Append(Stage::kSubmitTotal, start_ns,
+                             submit_end_ns - start_ns,
+                             matrix_mode
+                                 ? static_cast<uint16_t>(variant_idx)
+                                 : g_rtt_prober.LatestMicrosClamped());
+      } else {
+        std::cerr << "===END=" << submit_end_ns << "===" << std::endl;
+        std::cerr << "TOTAL_NS=" << (submit_end_ns - start_ns) << std::endl;
+      }
+
+      g_reporter.Send(Stage::kSubmitTotal, start_ns,
+                      submit_end_ns - start_ns,
+                      matrix_mode ? static_cast<uint16_t>(variant_idx) : 0);
+
+#ifdef LATENCYLAB_SDK_SERVER_TS
+      // Each ACK doubles as a clock sample; the splits say which
+      // direction a slow exchange spent its time in.
+      g_clock_sync.AddExchange(start_ns, result.server_timestamp_ns,
+                               submit_end_ns);
+      if (g_clock_sync.Ready() && g_latency_log.IsOpen()) {
+        int64_t offset = g_clock_sync.OffsetNs();
+        g_log_writer.Append(Stage::kClockOffset, submit_end_ns,
+                            static_cast<uint64_t>(offset < 0 ? -offset
+                                                             : offset),
+                            offset > 0 ? 1 : 0);
+        ClockSync::Split split = g_clock_sync.Decompose(
+            start_ns, result.server_timestamp_ns, submit_end_ns);
+        g_log_writer.Append(Stage::kOneWayOut, start_ns, split.outbound_ns);
+        g_log_writer.Append(Stage::kOneWayBack, start_ns, split.inbound_ns);
+      }
+#endif
+
+      if (auto shift = g_regime_detector.Record(submit_end_ns - start_ns)) {
+        if (g_latency_log.IsOpen()) {
+          g_log_writer.Append(Stage::kRegimeShift, start_ns, shift->p50_ns,
+                              shift->trigger);
+        }
+        std::cerr << "REGIME SHIFT: p50 "
+                  << (shift->baseline_p50_ns / 1000000.0) << "ms -> "
+                  << (shift->p50_ns / 1000000.0) << "ms, p99 "
+                  << (shift->baseline_p99_ns / 1000000.0) << "ms -> "
+                  << (shift->p99_ns / 1000000.0) << "ms (trigger "
+                  << shift->trigger << ")" << std::endl;
+      }
+
+      if (realtime_mode) {
+        uint64_t switches = callback_ctx.Delta();
+        if (switches > 0 && g_latency_log.IsOpen()) {
+          g_log_writer.Append(Stage::kCtxSwitch, start_ns, switches, 1);
+        }
+      }
+
+      // Outlier: freeze the sockwatch capture ring so this sample's
+      // packets reach disk before steady-state traffic overwrites them.
+      if (freeze_outlier_ns > 0 && sockwatch_capture_freeze &&
+          submit_end_ns - start_ns > freeze_outlier_ns) {
+        sockwatch_capture_freeze();
+      }
     }
 
     if (result.success) {
-      std::cerr << "Order submitted successfully!" << std::endl;
-      std::cerr << "Order ID: " << result.order_id << std::endl;
-      std::cerr << "Order Ticket ID: " << result.order_ticket_id << std::endl;
-
-      current_order_id = result.order_id;
-      current_order_ticket_id = result.order_ticket_id;
-
-      std::this_thread::sleep_for(std::chrono::seconds(1));
-      client->CancelOrder(current_order_id, current_order_ticket_id,
-                          order_info);
+      // One-shot runs keep the chatty confirmation; in daemon mode these
+      // cerr writes would hold up order-state delivery on the SDK thread
+      // every cycle.
+      if (!daemon_mode) {
+        std::cerr << "Order submitted successfully!" << std::endl;
+        std::cerr << "Order ID: " << result.order_id << std::endl;
+        std::cerr << "Order Ticket ID: " << result.order_ticket_id
+                  << std::endl;
+      }
+
+      current_order_id = g_cycle_arena.CopyString(result.order_id);
+      current_order_ticket_id = g_cycle_arena.CopyString(result.order_ticket_id);
+
+      // Cancel fires from the scheduler thread; the SDK callback thread
+      // returns immediately instead of sleeping for a second.
+      cancel_scheduler.ScheduleAfter(
+          std::chrono::milliseconds(cancel_delay_ms), [&] {
+            cancel_start_ns = ProbeClock::NowNs();
+            client->CancelOrder(std::string(current_order_id),
+                                std::string(current_order_ticket_id),
+                                *cycle_order);
+          });
     } else {
       std::cerr << "Order submission failed: " << result.error_message
                 << std::endl;
     }
 
-    {
-      std::lock_guard<std::mutex> lock(mtx);
-      order_submitted = true;
-    }
-    cv.notify_one();
+    submit_done.Signal();
   });
 
   client->SetOrderCancelCallback([&](const OrderCancelResult& result) {
+    if (enable_timing && !warming && cancel_start_ns != 0) {
+      uint64_t cancel_total_ns = ProbeClock::NowNs() - cancel_start_ns;
+      g_cancel_histogram.Record(cancel_total_ns);
+      g_budget.Observe(Stage::kCancelTotal, cancel_start_ns, cancel_total_ns);
+      if (g_latency_log.IsOpen()) {
+        g_log_writer.Append(Stage::kCancelTotal, cancel_start_ns,
+                             cancel_total_ns);
+      }
+    }
+
     if (result.success) {
-      std::cerr << "Order cancelled successfully!" << std::endl;
+      if (!daemon_mode) {
+        std::cerr << "Order cancelled successfully!" << std::endl;
+      }
     } else {
       std::cerr << "Order cancellation failed: " << result.error_message
                 << std::endl;
     }
 
-    {
-      std::lock_guard<std::mutex> lock(mtx);
-      order_cancelled = true;
-    }
-    cancel_cv.notify_one();
+    cancel_done.Signal();
   });
 
-  if (!client->Connect()) {
-    std::cerr << "Failed to connect" << std::endl;
-    return 1;
+  if (daemon_mode) {
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+    signal(SIGUSR1, handleStatsSignal);
   }
-  std::this_thread::sleep_for(std::chrono::seconds(1));
-  if (!client->Login()) {
-    std::cerr << "Failed to login" << std::endl;
+
+  // The keeper owns session lifetime: millisecond readiness polling
+  // instead of the old fixed 1s sleeps, and in daemon mode a monitor
+  // that re-logs in with backoff when the broker drops us, logging the
+  // outage window instead of exiting.
+  SessionKeeper keeper(*client,
+                       g_latency_log.IsOpen() ? &g_log_writer : nullptr);
+  if (!keeper.EstablishFirst()) {
+    std::cerr << "Failed to connect" << std::endl;
     return 1;
   }
-  std::this_thread::sleep_for(std::chrono::seconds(1));
   std::cerr << "Connected and logged in" << std::endl;
+  if (daemon_mode) {
+    keeper.StartMonitor();
+  }
 
-  if (enable_timing) {
-    auto start = std::chrono::high_resolution_clock::now();
-    start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                   start.time_since_epoch())
-                   .count();
-    std::cerr << "===START=" << start_ns << "===" << std::endl;
+  // Warmup: real submit/cancel exchanges on the fresh channel (the SDK has
+  // no lighter RPC), untimed, so the first timed sample never pays gRPC
+  // HEADERS/settings negotiation. The arena and log pages were already
+  // faulted in at construction/Open; this primes the channel and the code
+  // path itself.
+  if (warmup_cycles > 0) {
+    warming = true;
+    ProbeTiming::SetSink(&quietSink);
+    std::cerr << "Warmup: " << warmup_cycles << " untimed exchanges"
+              << std::endl;
+    for (int w = 0; w < warmup_cycles && !g_stop_requested; w++) {
+      g_cycle_arena.Reset();
+      client->SubmitOrder(order_info);
+      if (!submit_done.WaitNext(std::chrono::seconds(10))) {
+        std::cerr << "Warmup submit timeout" << std::endl;
+        break;
+      }
+      if (!cancel_done.WaitNext(std::chrono::seconds(10))) {
+        std::cerr << "Warmup cancel timeout" << std::endl;
+        break;
+      }
+    }
+    warming = false;
+    ProbeTiming::SetSink(
+        g_latency_log.IsOpen()
+            ? &logSink
+            : (g_budget.Enabled() ? &budgetStderrSink
+                                  : &latencylab::ActiveTiming::StderrSink));
+  }
+
+  // Connect/login above is paid once; each iteration below reuses the warm
+  // gRPC channel, so daemon mode measures steady-state rather than cold-start
+  // latency. One-shot mode is a single iteration of the same cycle.
+  uint64_t cycle_count = 0;
+
+  if (spin_core >= 0) {
+    latencylab::PinThisThread(spin_core);
+  }
+  if (realtime_mode) {
+    latencylab::EnableRealtime(rt_core);
   }
 
-  client->SubmitOrder(order_info);
+  do {
+    if (daemon_mode && !keeper.Ready()) {
+      // Outage in progress: the keeper is re-logging in with backoff.
+      // Don't time submits into a dead channel; the gap shows up as the
+      // kSessionOutage record.
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      continue;
+    }
+
+    cycle_count++;
+    g_cycle_arena.Reset();
+
+    variant_idx = (cycle_count - 1) % variants.size();
+    cycle_order = &variants[variant_idx].prepared.order();
+
+    if (daemon_mode) {
+      std::cerr << "--- Cycle #" << cycle_count;
+      if (matrix_mode) {
+        std::cerr << " [" << variants[variant_idx].label << "]";
+      }
+      std::cerr << " ---" << std::endl;
+    }
+
+    if (enable_timing) {
+      if (realtime_mode) {
+        submit_ctx.Begin();
+      }
+      start_ns = ProbeClock::NowNs();
+      if (!g_latency_log.IsOpen()) {
+        std::cerr << "===START=" << start_ns << "===" << std::endl;
+      }
+    }
 
-  {
-    std::unique_lock<std::mutex> lock(mtx);
-    bool success = cv.wait_for(lock, std::chrono::seconds(10),
-                               [&] { return order_submitted.load(); });
-    if (!success) {
+    client->SubmitOrder(*cycle_order);
+
+    if (!submit_done.WaitNext(std::chrono::seconds(10))) {
       std::cerr << "Order submission timeout" << std::endl;
-      return 1;
+      if (!daemon_mode) return 1;
+      continue;
+    }
+
+    if (enable_timing && realtime_mode) {
+      uint64_t switches = submit_ctx.Delta();
+      if (switches > 0 && g_latency_log.IsOpen()) {
+        g_log_writer.Append(Stage::kCtxSwitch, start_ns, switches, 0);
+      }
     }
-  }
 
-  {
-    std::unique_lock<std::mutex> lock(mtx);
-    bool success = cancel_cv.wait_for(lock, std::chrono::seconds(10),
-                                      [&] { return order_cancelled.load(); });
-    if (!success) {
+    if (!cancel_done.WaitNext(std::chrono::seconds(10))) {
       std::cerr << "Order cancellation timeout" << std::endl;
-      return 1;
+      if (!daemon_mode) return 1;
+      continue;
+    }
+
+    if (g_stats_requested.exchange(false)) {
+      g_submit_histogram.Print(std::cerr, "submit_total");
     }
+
+    if (daemon_mode && !g_stop_requested) {
+      std::cerr << "Waiting " << interval_seconds << "s before next cycle..."
+                << std::endl;
+      for (int waited = 0; waited < interval_seconds && !g_stop_requested;
+           waited++) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+      }
+    }
+  } while (daemon_mode && !g_stop_requested);
+
+  if (daemon_mode) {
+    std::cerr << "Stopping after " << cycle_count << " cycles" << std::endl;
+  }
+
+  if (enable_timing && g_submit_histogram.Count() > 0) {
+    g_submit_histogram.Print(std::cerr, "submit_total");
+  }
+  if (enable_timing && matrix_mode) {
+    for (size_t i = 0; i < variants.size(); i++) {
+      if (variant_histograms[i]->Count() > 0) {
+        variant_histograms[i]->Print(std::cerr, variants[i].label.c_str());
+      }
+    }
+  }
+  if (enable_timing && g_cancel_histogram.Count() > 0) {
+    g_cancel_histogram.Print(std::cerr, "cancel_total");
   }
 
+  keeper.Stop();
   if (client->IsConnected()) {
     client->Disconnect();
   }
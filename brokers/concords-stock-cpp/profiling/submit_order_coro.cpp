@@ -0,0 +1,163 @@
+/**
+ * Coroutine-based submit probe: the order lifecycle as one linear function.
+ *
+ * Same measurement as submit_order --daemon, but the submit/cancel state
+ * machine is a single coroutine over order_awaitable.h — resumed directly
+ * on the SDK callback thread, so there is no condvar or futex wakeup in
+ * the measured window at all.
+ *
+ * Usage:
+ *     ./submit_order_coro [--config order_config.toml] [--cycles N]
+ *                         [--interval N] [--log latency.bin]
+ */
+
+#include <toml++/toml.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include "stock-client/order.h"
+#include "stock-client/stock_client.h"
+
+#include "binary_log.h"
+#include "completion.h"
+#include "histogram.h"
+#include "log_ring.h"
+#include "order_awaitable.h"
+#include "order_config.h"
+#include "order_template.h"
+#include "stage_timer.h"
+#include "tsc_clock.h"
+
+using namespace concordsapi::stockclient;
+
+using latencylab::AsyncStockClient;
+using latencylab::BinaryLog;
+using latencylab::Completion;
+using latencylab::InstrumentedStockClient;
+using latencylab::LatencyHistogram;
+using latencylab::LogRingWriter;
+using latencylab::PreparedOrder;
+using latencylab::ProbeClock;
+using latencylab::ProbeTask;
+using latencylab::ProbeTiming;
+using latencylab::Stage;
+
+BinaryLog g_latency_log;
+LogRingWriter g_log_writer(g_latency_log);
+LatencyHistogram g_submit_histogram;
+
+std::atomic<bool> g_stop_requested{false};
+
+void handleStopSignal(int) { g_stop_requested = true; }
+
+ProbeTask runCycles(AsyncStockClient<ProbeTiming>& client,
+                    const OrderInfo& order_info, int cycles,
+                    int interval_seconds, Completion& done) {
+  for (int cycle = 0; cycle < cycles && !g_stop_requested; cycle++) {
+    uint64_t start_ns = ProbeClock::NowNs();
+    OrderSubmitResult submit = co_await client.Submit(order_info);
+    uint64_t total_ns = ProbeClock::NowNs() - start_ns;
+
+    g_submit_histogram.Record(total_ns);
+    if (g_latency_log.IsOpen()) {
+      g_log_writer.Append(Stage::kSubmitTotal, start_ns, total_ns);
+    }
+
+    if (submit.success) {
+      OrderCancelResult cancel = co_await client.Cancel(
+          submit.order_id, submit.order_ticket_id, order_info);
+      if (!cancel.success) {
+        std::cerr << "Cancel failed: " << cancel.error_message << std::endl;
+      }
+    } else {
+      std::cerr << "Submit failed: " << submit.error_message << std::endl;
+    }
+
+    // After a cancel resume we are on the SDK callback thread; sleeping
+    // here between cycles parks this coroutine, not the main thread.
+    for (int waited = 0; waited < interval_seconds && !g_stop_requested;
+         waited++) {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+  }
+  done.Signal();
+}
+
+int main(int argc, char* argv[]) {
+  const char* config_path = "order_config.toml";
+  const char* log_path = nullptr;
+  int cycles = 1;
+  int interval_seconds = 10;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+      config_path = argv[++i];
+    } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+      log_path = argv[++i];
+    } else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) {
+      cycles = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+      interval_seconds = atoi(argv[++i]);
+    }
+  }
+
+  ProbeClock::Calibrate();
+
+  auto config = toml::parse_file(config_path);
+  auto creds = latencylab::LoadCredentials(config["user"]);
+  PreparedOrder prepared = latencylab::BuildPreparedOrder(config);
+
+  if (log_path) {
+    if (!g_latency_log.Open(log_path, latencylab::kBrokerIdConcords,
+                            1 << 20)) {
+      return 1;
+    }
+    g_log_writer.Start();
+  }
+
+  InstrumentedStockClient<ProbeTiming> client(
+      BuildStockClient(creds.user_id.c_str(), creds.password.c_str(),
+                       creds.account.c_str(), creds.pfx_filepath.c_str(),
+                       creds.pfx_password.c_str()));
+  AsyncStockClient<ProbeTiming> async_client(client);
+
+  signal(SIGINT, handleStopSignal);
+  signal(SIGTERM, handleStopSignal);
+
+  if (!client.Connect()) {
+    std::cerr << "Failed to connect" << std::endl;
+    return 1;
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  if (!client.Login()) {
+    std::cerr << "Failed to login" << std::endl;
+    return 1;
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  std::cerr << "Connected and logged in" << std::endl;
+
+  Completion done(false);
+  runCycles(async_client, prepared.order(), cycles, interval_seconds, done);
+
+  if (!done.WaitNext(std::chrono::hours(24))) {
+    std::cerr << "Probe coroutine never finished" << std::endl;
+    return 1;
+  }
+
+  if (g_submit_histogram.Count() > 0) {
+    g_submit_histogram.Print(std::cerr, "submit_total");
+  }
+
+  if (client.IsConnected()) {
+    client.Disconnect();
+  }
+  return 0;
+}
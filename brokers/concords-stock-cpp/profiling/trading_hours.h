@@ -0,0 +1,112 @@
+/**
+ * Trading-hours gating, ported from the Python probe's run_latency_test
+ * loop so every C++ harness shares one implementation: HH:MM window,
+ * Mon-Fri only, all in Taiwan time (UTC+8, no DST). Time arithmetic is
+ * done on the raw epoch rather than through localtime() so container TZ
+ * configuration cannot skew the gate — the same choice log_analyzer makes
+ * for its time-of-day bins.
+ *
+ * Config ([trading_hours] section, same shape as the Python configs):
+ *     [trading_hours]
+ *     start_time = "08:30"
+ *     end_time = "13:30"
+ *     interval_seconds = 300
+ */
+
+#pragma once
+
+#include <toml++/toml.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+namespace latencylab {
+
+// "08:30" -> 830; the HHMM-integer comparison the Python loop uses.
+inline int ParseHhmm(const std::string& str) {
+  size_t colon = str.find(':');
+  if (colon == std::string::npos || colon == 0 ||
+      colon + 1 >= str.size()) {
+    std::cerr << "Invalid HH:MM time: " << str << std::endl;
+    exit(1);
+  }
+  int hours = atoi(str.substr(0, colon).c_str());
+  int minutes = atoi(str.substr(colon + 1).c_str());
+  if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59) {
+    std::cerr << "Invalid HH:MM time: " << str << std::endl;
+    exit(1);
+  }
+  return hours * 100 + minutes;
+}
+
+struct TradingHours {
+  // Disabled (always in-window) until Configure() is called, so harnesses
+  // without a [trading_hours] section just run.
+  bool enabled = false;
+  int start_hhmm = 0;
+  int end_hhmm = 0;
+  int interval_seconds = 0;
+
+  void Configure(int start, int end, int interval) {
+    start_hhmm = start;
+    end_hhmm = end;
+    interval_seconds = interval;
+    enabled = true;
+  }
+
+  // Current HHMM in Taiwan time for the given epoch second.
+  static int TaiwanHhmm(time_t now_utc) {
+    int64_t seconds_of_day = (static_cast<int64_t>(now_utc) + 8 * 3600) % 86400;
+    return static_cast<int>(seconds_of_day / 3600) * 100 +
+           static_cast<int>((seconds_of_day / 60) % 60);
+  }
+
+  // Monday..Friday in Taiwan time. 1970-01-01 was a Thursday, so day 0
+  // maps to weekday 3 with Monday as 0 (the Python weekday() convention).
+  static bool TaiwanWeekday(time_t now_utc) {
+    int64_t days = (static_cast<int64_t>(now_utc) + 8 * 3600) / 86400;
+    return (days + 3) % 7 < 5;
+  }
+
+  bool InWindow(time_t now_utc) const {
+    if (!enabled) {
+      return true;
+    }
+    if (!TaiwanWeekday(now_utc)) {
+      return false;
+    }
+    int hhmm = TaiwanHhmm(now_utc);
+    return start_hhmm <= hhmm && hhmm <= end_hhmm;
+  }
+};
+
+// Reads the [trading_hours] section; absent section leaves the gate
+// disabled. interval_seconds must be positive when the section exists,
+// as in the Python config validation.
+inline TradingHours LoadTradingHours(const toml::table& config) {
+  TradingHours hours;
+  auto section = config["trading_hours"];
+  auto start = section["start_time"].value<std::string>();
+  auto end = section["end_time"].value<std::string>();
+  if (!start && !end) {
+    return hours;
+  }
+  if (!start || !end) {
+    std::cerr << "[trading_hours] needs both start_time and end_time"
+              << std::endl;
+    exit(1);
+  }
+  int interval = section["interval_seconds"].value_or(0);
+  if (interval <= 0) {
+    std::cerr << "[trading_hours].interval_seconds must be positive"
+              << std::endl;
+    exit(1);
+  }
+  hours.Configure(ParseHhmm(*start), ParseHhmm(*end), interval);
+  return hours;
+}
+
+}  // namespace latencylab
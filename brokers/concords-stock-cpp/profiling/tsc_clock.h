@@ -0,0 +1,111 @@
+/**
+ * Calibrated TSC clock for probe timestamps.
+ *
+ * Every stage marker costs one clock read, so once probes multiply the
+ * clock itself becomes the overhead: clock_gettime via the vDSO is ~20ns,
+ * RDTSC is a few ns. ProbeClock reads the invariant TSC (serialized with
+ * LFENCE so it cannot be reordered around the work being measured),
+ * converts ticks to nanoseconds with a scale calibrated against the chrono
+ * clock at startup, and anchors to the same epoch as
+ * std::chrono::high_resolution_clock so TSC and chrono timestamps mix in
+ * one log. Hardware without invariant TSC falls back to chrono.
+ *
+ * Call ProbeClock::Calibrate() once at startup, before the first sample.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include <chrono>
+
+namespace latencylab {
+
+class ProbeClock {
+ public:
+  static void Calibrate() {
+    state().calibrated = true;
+#if defined(__x86_64__)
+    if (!HasInvariantTsc()) return;
+
+    // Two anchor points ~10ms apart give a scale good to ~1e-4. Invariant
+    // TSC does not drift with P-states, so one anchor holds for probe
+    // lifetimes of hours.
+    uint64_t tsc0 = ReadTsc();
+    uint64_t ns0 = ChronoNowNs();
+    auto spin_until = std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds(10);
+    while (std::chrono::steady_clock::now() < spin_until) {
+    }
+    uint64_t tsc1 = ReadTsc();
+    uint64_t ns1 = ChronoNowNs();
+    if (tsc1 <= tsc0 || ns1 <= ns0) return;
+
+    state().ns_per_tick =
+        static_cast<double>(ns1 - ns0) / static_cast<double>(tsc1 - tsc0);
+    state().base_tsc = tsc1;
+    state().base_ns = ns1;
+    state().use_tsc = true;
+#endif
+  }
+
+  static bool UsingTsc() { return state().use_tsc; }
+
+  static uint64_t NowNs() {
+#if defined(__x86_64__)
+    if (state().use_tsc) {
+      uint64_t ticks = ReadTsc() - state().base_tsc;
+      return state().base_ns +
+             static_cast<uint64_t>(static_cast<double>(ticks) *
+                                   state().ns_per_tick);
+    }
+#endif
+    return ChronoNowNs();
+  }
+
+#if defined(__x86_64__)
+  // Raw serialized tick read; public for cycle-accurate counters in the
+  // micro-benchmarks. Meaningless across cores without invariant TSC.
+  static uint64_t ReadTsc() {
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+  }
+#endif
+
+ private:
+  struct State {
+    bool calibrated = false;
+    bool use_tsc = false;
+    double ns_per_tick = 0.0;
+    uint64_t base_tsc = 0;
+    uint64_t base_ns = 0;
+  };
+
+  static State& state() {
+    static State s;
+    return s;
+  }
+
+  static uint64_t ChronoNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::high_resolution_clock::now().time_since_epoch())
+        .count();
+  }
+
+#if defined(__x86_64__)
+  static bool HasInvariantTsc() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+    return (edx & (1u << 8)) != 0;  // APM: invariant TSC
+  }
+#endif
+};
+
+}  // namespace latencylab
@@ -0,0 +1,108 @@
+/**
+ * Probe-side emitter for UDP latency reports.
+ *
+ * The old report path was one HTTPS POST of JSON per sample with a 5s
+ * timeout — on the measurement box, per order. A report is now a single
+ * sendto of one 64-byte ReportPacket on a connected non-blocking UDP
+ * socket: fire-and-forget, never blocks, and a down collector costs
+ * nothing but the dropped datagram.
+ *
+ * Config ([report] section of the probe config):
+ *     [report]
+ *     collector = "collector.example.com:9901"
+ */
+
+#pragma once
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "report_packet.h"
+#include "stages.h"
+
+namespace latencylab {
+
+class UdpReporter {
+ public:
+  UdpReporter() = default;
+
+  ~UdpReporter() {
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  UdpReporter(const UdpReporter&) = delete;
+  UdpReporter& operator=(const UdpReporter&) = delete;
+
+  // "host:port"; resolves once and connects the socket so each report is
+  // a plain send with no address lookup.
+  bool Open(const std::string& spec, uint32_t broker_id) {
+    size_t colon = spec.rfind(':');
+    if (colon == std::string::npos || colon == 0 ||
+        colon + 1 == spec.size()) {
+      std::cerr << "Invalid collector address (want host:port): " << spec
+                << std::endl;
+      return false;
+    }
+    std::string host = spec.substr(0, colon);
+    std::string port = spec.substr(colon + 1);
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    int rc = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+    if (rc != 0 || !result) {
+      std::cerr << "Cannot resolve collector " << host << ": "
+                << gai_strerror(rc) << std::endl;
+      return false;
+    }
+    fd_ = socket(result->ai_family, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (fd_ < 0 || connect(fd_, result->ai_addr, result->ai_addrlen) != 0) {
+      std::cerr << "Cannot connect collector socket" << std::endl;
+      freeaddrinfo(result);
+      if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+      }
+      return false;
+    }
+    freeaddrinfo(result);
+    broker_id_ = broker_id;
+    return true;
+  }
+
+  bool IsOpen() const { return fd_ >= 0; }
+
+  // One datagram, never blocks; send failures are silently dropped, the
+  // local binary log remains the source of truth.
+  void Send(Stage stage, uint64_t timestamp_ns, uint64_t duration_ns,
+            uint16_t flags = 0, const char* label = "") noexcept {
+    if (fd_ < 0) {
+      return;
+    }
+    ReportPacket packet = {};
+    packet.magic = kReportMagic;
+    packet.version = kReportVersion;
+    packet.stage_id = static_cast<uint16_t>(stage);
+    packet.broker_id = broker_id_;
+    packet.flags = flags;
+    packet.timestamp_ns = timestamp_ns;
+    packet.duration_ns = duration_ns;
+    strncpy(packet.label, label, sizeof(packet.label) - 1);
+    send(fd_, &packet, sizeof(packet), MSG_DONTWAIT);
+  }
+
+ private:
+  int fd_ = -1;
+  uint32_t broker_id_ = 0;
+};
+
+}  // namespace latencylab
@@ -1,4 +1,6 @@
 import shioaji as sj
+import socket
+import struct
 import time
 import requests
 import toml
@@ -19,6 +21,15 @@ CANCEL_TIMEOUT = 10
 
 TAIWAN_TZ = timezone(timedelta(hours=8))
 
+# UDP report wire format, shared with the C++ probes and the collector
+# (see brokers/concords-stock-cpp/profiling/report_packet.h): one 64-byte
+# little-endian datagram per sample.
+REPORT_MAGIC = 0x50524C4C  # "LLRP"
+REPORT_VERSION = 1
+REPORT_STRUCT = struct.Struct("<IHHIHHQQ32s")
+STAGE_SUBMIT_TOTAL = 7  # latencylab::Stage::kSubmitTotal
+BROKER_ID_SINOTRADE = 2  # latencylab::kBrokerIdSinotrade
+
 
 class LatencyMeasurement:
     """Measures order submission latency for Sinotrade stock trading."""
@@ -42,6 +53,18 @@ class LatencyMeasurement:
         self.order_event = threading.Event()
         self.cancel_event = threading.Event()
 
+        # Optional UDP collector: one connected fire-and-forget socket,
+        # created once. Falls back to the legacy HTTPS report when no
+        # [report] collector is configured.
+        self.report_socket = None
+        collector = self.config.get("report", {}).get("collector", "")
+        if collector:
+            host, _, port = collector.rpartition(":")
+            self.report_socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+            self.report_socket.setblocking(False)
+            self.report_socket.connect((host, int(port)))
+            logger.info(f"Reporting to collector at {collector}")
+
         # Cache parsed constants
         self._action_map = {
             "buy": sj.constant.Action.Buy,
@@ -414,7 +437,26 @@ class LatencyMeasurement:
             return False
 
     def send_latency_report(self, symbol, side, price, volume, latency_ms):
-        """Send latency report to API."""
+        """Send latency report: one UDP datagram to the collector when one
+        is configured, otherwise the legacy HTTPS POST."""
+        if self.report_socket is not None:
+            try:
+                packet = REPORT_STRUCT.pack(
+                    REPORT_MAGIC,
+                    REPORT_VERSION,
+                    STAGE_SUBMIT_TOTAL,
+                    BROKER_ID_SINOTRADE,
+                    0,
+                    0,
+                    time.time_ns(),
+                    int(latency_ms * 1e6),
+                    symbol.encode()[:31],
+                )
+                self.report_socket.send(packet)
+            except OSError:
+                pass  # fire-and-forget; the local log is the record
+            return
+
         try:
             api_url = self.config["api"]["url"]
             broker_name = self.config["api"]["broker_name"]
@@ -0,0 +1,179 @@
+/**
+ * Central collector for UDP latency reports from all probes.
+ *
+ * Probes emit one 64-byte ReportPacket per sample (udp_reporter.h for the
+ * C++ harness; the Python probes pack the same layout). The collector
+ * appends each valid packet into a per-broker mapped log in the standard
+ * binary format — so log_reader and the analyzers work on central data
+ * unchanged — and keeps per-broker histograms of submit totals: one
+ * cumulative since start, one rolling window printed and reset every
+ * stats interval.
+ *
+ * Build:
+ *     g++ -std=c++20 -O2 -I../brokers/concords-stock-cpp/profiling \
+ *         latency_collector.cpp -o latency_collector -lpthread
+ *
+ * Usage:
+ *     ./latency_collector [--port 9901] [--out-dir .] [--stats-interval 60]
+ *
+ * SIGUSR1 prints the cumulative histograms on demand; SIGINT/SIGTERM
+ * flush and exit.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "binary_log.h"
+#include "histogram.h"
+#include "report_packet.h"
+#include "stages.h"
+
+using latencylab::BinaryLog;
+using latencylab::LatencyHistogram;
+using latencylab::ReportPacket;
+using latencylab::Stage;
+
+std::atomic<bool> g_stop_requested{false};
+
+void handleStopSignal(int) { g_stop_requested = true; }
+
+std::atomic<bool> g_stats_requested{false};
+
+void handleStatsSignal(int) { g_stats_requested = true; }
+
+// Everything tracked for one reporting broker, created on first packet.
+struct BrokerState {
+  BinaryLog log;
+  LatencyHistogram cumulative;
+  LatencyHistogram window;
+  uint64_t packets = 0;
+};
+
+int main(int argc, char* argv[]) {
+  int port = 9901;
+  const char* out_dir = ".";
+  int stats_interval = 60;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+      port = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--out-dir") == 0 && i + 1 < argc) {
+      out_dir = argv[++i];
+    } else if (strcmp(argv[i], "--stats-interval") == 0 && i + 1 < argc) {
+      stats_interval = atoi(argv[++i]);
+    }
+  }
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    std::cerr << "Cannot create socket: " << strerror(errno) << std::endl;
+    return 1;
+  }
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(static_cast<uint16_t>(port));
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    std::cerr << "Cannot bind port " << port << ": " << strerror(errno)
+              << std::endl;
+    return 1;
+  }
+
+  // A receive timeout keeps the loop responsive to signals and drives the
+  // stats interval without a second thread.
+  timeval timeout = {1, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  signal(SIGINT, handleStopSignal);
+  signal(SIGTERM, handleStopSignal);
+  signal(SIGUSR1, handleStatsSignal);
+
+  std::cerr << "Collecting on UDP port " << port << ", logs in " << out_dir
+            << std::endl;
+
+  std::map<uint32_t, std::unique_ptr<BrokerState>> brokers;
+  uint64_t rejected = 0;
+  time_t window_start = time(nullptr);
+
+  while (!g_stop_requested) {
+    ReportPacket packet;
+    ssize_t received = recv(fd, &packet, sizeof(packet), 0);
+
+    if (received == sizeof(packet) &&
+        packet.magic == latencylab::kReportMagic &&
+        packet.version == latencylab::kReportVersion &&
+        packet.stage_id < static_cast<uint16_t>(Stage::kStageCount)) {
+      auto& state = brokers[packet.broker_id];
+      if (!state) {
+        state = std::make_unique<BrokerState>();
+        std::string path = std::string(out_dir) + "/broker_" +
+                           std::to_string(packet.broker_id) + ".bin";
+        // 1M records per broker, same capacity as the local probe logs.
+        if (!state->log.Open(path.c_str(), packet.broker_id, 1 << 20)) {
+          return 1;
+        }
+        std::cerr << "New broker " << packet.broker_id << " -> " << path
+                  << std::endl;
+      }
+      state->packets++;
+      state->log.Append(static_cast<Stage>(packet.stage_id),
+                        packet.timestamp_ns, packet.duration_ns,
+                        packet.flags);
+      if (packet.stage_id == static_cast<uint16_t>(Stage::kSubmitTotal)) {
+        state->cumulative.Record(packet.duration_ns);
+        state->window.Record(packet.duration_ns);
+      }
+    } else if (received >= 0) {
+      rejected++;
+    }
+
+    if (g_stats_requested.exchange(false)) {
+      for (auto& [broker_id, state] : brokers) {
+        std::string label = "broker_" + std::to_string(broker_id);
+        state->cumulative.Print(std::cerr, label.c_str());
+      }
+    }
+
+    if (stats_interval > 0 &&
+        time(nullptr) - window_start >= stats_interval) {
+      for (auto& [broker_id, state] : brokers) {
+        if (state->window.Count() > 0) {
+          std::string label =
+              "broker_" + std::to_string(broker_id) + " (window)";
+          state->window.Print(std::cerr, label.c_str());
+          state->window.Reset();
+        }
+      }
+      window_start = time(nullptr);
+    }
+  }
+
+  std::cerr << "Stopping" << std::endl;
+  for (auto& [broker_id, state] : brokers) {
+    std::cerr << "broker " << broker_id << ": " << state->packets
+              << " packets" << std::endl;
+    if (state->cumulative.Count() > 0) {
+      std::string label = "broker_" + std::to_string(broker_id);
+      state->cumulative.Print(std::cerr, label.c_str());
+    }
+    state->log.Close();
+  }
+  if (rejected > 0) {
+    std::cerr << rejected << " malformed packets rejected" << std::endl;
+  }
+  close(fd);
+  return 0;
+}